@@ -0,0 +1,432 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 17 Oct 2026 9:14:37pm
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <iostream>
+#include "../PluginProcessor.h"
+#include "RealtimeCheck.h"
+
+/*
+ Microbenchmarks for the audio path.
+
+     SimpleMBCompBench [--out results.json] [--baseline baseline.json] [--tolerance 5] [--full]
+     SimpleMBCompBench --rtcheck [--blocks N] [--seed N]
+     SimpleMBCompBench --fifocheck [--items N] [--seed N]
+
+ processBlock is swept over block size, sample rate, channel count and band state. Each sweep
+ moves one of them away from the default case (512 samples, 48kHz, stereo, all bands active),
+ and --full runs the whole cross product instead. The block size sweep is run once more with
+ the linear-phase crossover. The stages behind it (the band split,
+ CompressorBand::process, the band mix and the gain kernel next to juce::dsp::Compressor)
+ are timed on their own over the block sizes.
+
+ Every figure is ns per sample frame (all channels), the median of several runs, with the
+ cost of restoring the input between blocks taken out. "budget" is that figure as a share of
+ one sample period, i.e. the CPU a single instance takes from one core in real time.
+ With --baseline, cases that got slower by more than --tolerance percent are listed and the
+ exit code is 1, so it can gate a CI job.
+ */
+
+//the plugin only ever builds three bands, these keep the rest of the band counts compiling
+template struct MultibandCore<float, 2>;
+template struct MultibandCore<float, 4>;
+template struct MultibandCore<double, 8>;
+
+namespace
+{
+    constexpr int SamplesPerRun = 1 << 17;
+    constexpr int NumRuns = 5;
+
+    const std::array<int, 9> BlockSizes{ 16, 32, 64, 128, 256, 512, 1024, 2048, 4096 };
+    const std::array<double, 6> SampleRates{ 44100.0, 48000.0, 88200.0, 96000.0, 192000.0, 384000.0 };
+    const std::array<int, 5> ChannelCounts{ 1, 2, 6, 12, 16 };
+    const std::array<const char*, 4> BandStates{ "active", "bypassed", "soloed", "muted" };
+
+    constexpr int DefaultBlockSize = 512;
+    constexpr double DefaultSampleRate = 48000.0;
+    constexpr int DefaultChannels = 2;
+
+    struct Result
+    {
+        juce::String group, state;
+        double sampleRate{ 0 };
+        int blockSize{ 0 }, numChannels{ 0 };
+        double nsPerSample{ 0 };
+
+        juce::String getKey() const
+        {
+            return group + "/" + juce::String(sampleRate, 0) + "Hz/" + juce::String(blockSize) + "/"
+                 + juce::String(numChannels) + "ch" + (state.isEmpty() ? juce::String() : "/" + state);
+        }
+
+        double getBudgetPercent() const { return 100.0 * nsPerSample * sampleRate / 1.0e9; }
+    };
+
+    juce::AudioBuffer<float> makeNoise(int numChannels, int numSamples)
+    {
+        //-12dBFS noise, well over the -30dB threshold the cases run at
+        juce::Random random(0x5eed);
+        juce::AudioBuffer<float> noise(numChannels, numSamples);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                noise.setSample(ch, i, 0.25f * (2.f * random.nextFloat() - 1.f));
+
+        return noise;
+    }
+
+    /** median ns per sample frame of processBlock(), minus what restoreInput() costs on its own */
+    template <typename RestoreInput, typename ProcessBlock>
+    double timeBlocks(int blockSize, RestoreInput&& restoreInput, ProcessBlock&& processBlock)
+    {
+        const auto numBlocks = juce::jmax(1, SamplesPerRun / blockSize);
+
+        auto timeLoop = [&](bool includeProcessing)
+        {
+            auto start = juce::Time::getHighResolutionTicks();
+
+            for (int i = 0; i < numBlocks; ++i)
+            {
+                restoreInput();
+                if (includeProcessing)
+                    processBlock();
+            }
+
+            return juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+        };
+
+        timeLoop(true); //warm up caches, branch predictors and the smoothers
+
+        std::array<double, NumRuns> runs;
+        for (auto& run : runs)
+            run = juce::jmax(0.0, timeLoop(true) - timeLoop(false));
+
+        std::sort(runs.begin(), runs.end());
+        return runs[NumRuns / 2] * 1.0e9 / (static_cast<double>(numBlocks) * blockSize);
+    }
+
+    void setParameter(SimpleMBCompAudioProcessor& processor, Params::names name, float value)
+    {
+        auto* parameter = processor.apvts.getParameter(Params::GetParams().at(name));
+        jassert(parameter != nullptr);
+        parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+    }
+
+    void setBandState(SimpleMBCompAudioProcessor& processor, const juce::String& state)
+    {
+        using namespace Params;
+
+        for (size_t band = 0; band < NumBands; ++band)
+        {
+            setParameter(processor, getBandParam(names::Threshold_Low_Band, band), -30.f);
+            setParameter(processor, getBandParam(names::Bypassed_Low_Band, band), state == "bypassed" ? 1.f : 0.f);
+            setParameter(processor, getBandParam(names::Solo_Low_Band, band), state == "soloed" && band == 1 ? 1.f : 0.f);
+            setParameter(processor, getBandParam(names::Mute_Low_Band, band), state == "muted" && band == 1 ? 1.f : 0.f);
+        }
+    }
+
+    void prepareProcessor(SimpleMBCompAudioProcessor& processor, double sampleRate, int blockSize, int numChannels,
+                          const juce::String& state, bool linearPhase = false)
+    {
+        auto layout = processor.getBusesLayout();
+        layout.inputBuses.getReference(0) = juce::AudioChannelSet::canonicalChannelSet(numChannels);
+        layout.outputBuses.getReference(0) = juce::AudioChannelSet::canonicalChannelSet(numChannels);
+
+        processor.releaseResources();
+        auto layoutApplied = processor.setBusesLayout(layout);
+        jassert(layoutApplied);
+        juce::ignoreUnused(layoutApplied);
+
+        setBandState(processor, state);
+        setParameter(processor, Params::names::Linear_Phase_Crossover, linearPhase ? 1.f : 0.f);
+        processor.prepareToPlay(sampleRate, blockSize);
+    }
+
+    Result benchProcessBlock(SimpleMBCompAudioProcessor& processor, double sampleRate, int blockSize, int numChannels,
+                             const juce::String& state, bool linearPhase = false)
+    {
+        prepareProcessor(processor, sampleRate, blockSize, numChannels, state, linearPhase);
+
+        auto input = makeNoise(numChannels, blockSize);
+        juce::AudioBuffer<float> buffer(processor.getTotalNumInputChannels(), blockSize);
+        juce::MidiBuffer midi;
+
+        Result result{ linearPhase ? "processBlockLinearPhase" : "processBlock", state, sampleRate, blockSize, numChannels };
+        result.nsPerSample = timeBlocks(blockSize,
+                                        [&] { buffer.makeCopyOf(input, true); },
+                                        [&] { processor.processBlock(buffer, midi); });
+        return result;
+    }
+
+    void benchStages(SimpleMBCompAudioProcessor& processor, int blockSize, std::vector<Result>& results)
+    {
+        constexpr auto NumBands = Params::NumBands;
+        const juce::dsp::ProcessSpec spec{ DefaultSampleRate, static_cast<juce::uint32>(blockSize), DefaultChannels };
+
+        auto input = makeNoise(DefaultChannels, blockSize);
+        juce::AudioBuffer<float> buffer(DefaultChannels, blockSize);
+        std::array<juce::AudioBuffer<float>, NumBands> bands;
+        for (auto& band : bands)
+            band.makeCopyOf(input);
+
+        auto addResult = [&](const juce::String& group, double nsPerSample)
+        {
+            Result result{ group, {}, DefaultSampleRate, blockSize, DefaultChannels };
+            result.nsPerSample = nsPerSample;
+            results.push_back(result);
+        };
+
+        //the band split
+        LinkwitzRileyCrossover<float, NumBands> crossover;
+        crossover.setCrossoverFrequency(0, 400.f);
+        crossover.setCrossoverFrequency(1, 2000.f);
+        crossover.prepare(spec);
+
+        std::array<juce::dsp::AudioBlock<float>, NumBands> bandBlocks;
+        for (size_t band = 0; band < NumBands; ++band)
+            bandBlocks[band] = juce::dsp::AudioBlock<float>(bands[band]);
+
+        addResult("splitBands", timeBlocks(blockSize,
+                                           [] {},
+                                           [&] { crossover.process(juce::dsp::AudioBlock<const float>(input), bandBlocks); }));
+
+        //one compressor band, wired to the processor's parameters
+        prepareProcessor(processor, DefaultSampleRate, blockSize, DefaultChannels, "active");
+
+        auto& compressor = processor.floatCore.compressors[1];
+        compressor.updateCompressorSettings();
+
+        //in the same serial sub-blocks the core feeds it
+        constexpr auto SubBlockSize = MultibandCore<float, NumBands>::InternalBlockSize;
+
+        addResult("compressorBand", timeBlocks(blockSize,
+                                               [&] { buffer.makeCopyOf(input, true); },
+                                               [&]
+                                               {
+                                                   for (int start = 0; start < blockSize; start += SubBlockSize)
+                                                   {
+                                                       juce::AudioBuffer<float> subBlock(buffer.getArrayOfWritePointers(), buffer.getNumChannels(),
+                                                                                         start, juce::jmin(SubBlockSize, blockSize - start));
+                                                       compressor.process(subBlock);
+                                                   }
+                                               }));
+
+        //summing the bands back up
+        BandMixer<float, NumBands> mixer;
+        mixer.prepare(spec);
+
+        std::array<float, NumBands> mask;
+        mask.fill(1.f);
+
+        addResult("mix", timeBlocks(blockSize,
+                                    [] {},
+                                    [&] { mixer.process(buffer, bands, mask); }));
+    }
+
+    /** the gain kernel against the juce::dsp::Compressor it replaced, gain computed and applied */
+    void benchDetector(double sampleRate, int blockSize, std::vector<Result>& results)
+    {
+        const juce::dsp::ProcessSpec spec{ sampleRate, static_cast<juce::uint32>(blockSize), DefaultChannels };
+
+        auto input = makeNoise(DefaultChannels, blockSize);
+        juce::AudioBuffer<float> buffer(DefaultChannels, blockSize);
+        juce::AudioBuffer<float> gains(DefaultChannels, blockSize);
+
+        CompressorKernel<float> kernel;
+        kernel.prepare(sampleRate, DefaultChannels);
+        kernel.setAttackTime(50.f);
+        kernel.setReleaseTime(250.f);
+        kernel.setThreshold(-30.f);
+        kernel.setRatio(3.f);
+
+        juce::dsp::Compressor<float> reference;
+        reference.prepare(spec);
+        reference.setAttack(50.f);
+        reference.setRelease(250.f);
+        reference.setThreshold(-30.f);
+        reference.setRatio(3.f);
+
+        auto restore = [&] { buffer.makeCopyOf(input, true); };
+
+        Result kernelResult{ "compressorKernel", {}, sampleRate, blockSize, DefaultChannels };
+        kernelResult.nsPerSample = timeBlocks(blockSize, restore, [&]
+        {
+            auto block = juce::dsp::AudioBlock<float>(buffer);
+            kernel.computeGains(block, gains);
+            block.multiplyBy(juce::dsp::AudioBlock<float>(gains));
+        });
+        results.push_back(kernelResult);
+
+        Result referenceResult{ "juceCompressor", {}, sampleRate, blockSize, DefaultChannels };
+        referenceResult.nsPerSample = timeBlocks(blockSize, restore, [&]
+        {
+            auto block = juce::dsp::AudioBlock<float>(buffer);
+            reference.process(juce::dsp::ProcessContextReplacing<float>(block));
+        });
+        results.push_back(referenceResult);
+    }
+
+    void print(const Result& result)
+    {
+        std::cout << result.getKey().paddedRight(' ', 48)
+                  << juce::String(result.nsPerSample, 2).paddedLeft(' ', 10) << " ns/sample"
+                  << juce::String(result.getBudgetPercent(), 3).paddedLeft(' ', 10) << " % budget" << std::endl;
+    }
+
+    juce::var toJson(const std::vector<Result>& results)
+    {
+        juce::Array<juce::var> cases;
+
+        for (const auto& result : results)
+        {
+            auto* object = new juce::DynamicObject();
+            object->setProperty("key", result.getKey());
+            object->setProperty("group", result.group);
+            object->setProperty("state", result.state);
+            object->setProperty("sampleRate", result.sampleRate);
+            object->setProperty("blockSize", result.blockSize);
+            object->setProperty("channels", result.numChannels);
+            object->setProperty("nsPerSample", result.nsPerSample);
+            object->setProperty("budgetPercent", result.getBudgetPercent());
+            cases.add(juce::var(object));
+        }
+
+        auto* root = new juce::DynamicObject();
+        root->setProperty("version", 1);
+        root->setProperty("cpu", juce::SystemStats::getCpuModel());
+        root->setProperty("cases", cases);
+        return juce::var(root);
+    }
+
+    /** returns the number of cases that got slower than the baseline by more than tolerancePercent */
+    int compareWithBaseline(const std::vector<Result>& results, const juce::var& baseline, double tolerancePercent)
+    {
+        std::map<juce::String, double> previous;
+        if (auto* cases = baseline["cases"].getArray())
+            for (const auto& entry : *cases)
+                previous[entry["key"].toString()] = static_cast<double>(entry["nsPerSample"]);
+
+        auto regressions = 0;
+        std::cout << std::endl << "against the baseline:" << std::endl;
+
+        for (const auto& result : results)
+        {
+            auto found = previous.find(result.getKey());
+            if (found == previous.end() || found->second <= 0.0)
+                continue;
+
+            auto change = 100.0 * (result.nsPerSample - found->second) / found->second;
+            auto isRegression = change > tolerancePercent;
+            regressions += isRegression ? 1 : 0;
+
+            std::cout << result.getKey().paddedRight(' ', 48)
+                      << (change >= 0 ? "+" : "") << juce::String(change, 1) << "%"
+                      << (isRegression ? "   <-- slower" : "") << std::endl;
+        }
+
+        return regressions;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ArgumentList args(argc, argv);
+
+    return juce::ConsoleApplication::invokeCatchingFailures([&]
+    {
+        if (args.containsOption("--rtcheck"))
+            return runRealtimeCheck(args);
+
+        if (args.containsOption("--fifocheck"))
+            return runFifoCheck(args);
+
+        const auto runFullMatrix = args.containsOption("--full");
+        std::vector<Result> results;
+
+        SimpleMBCompAudioProcessor processor;
+
+        auto runCase = [&](double sampleRate, int blockSize, int numChannels, const juce::String& state)
+        {
+            results.push_back(benchProcessBlock(processor, sampleRate, blockSize, numChannels, state));
+            print(results.back());
+        };
+
+        if (runFullMatrix)
+        {
+            for (auto sampleRate : SampleRates)
+                for (auto blockSize : BlockSizes)
+                    for (auto numChannels : ChannelCounts)
+                        for (auto* state : BandStates)
+                            runCase(sampleRate, blockSize, numChannels, state);
+        }
+        else
+        {
+            for (auto blockSize : BlockSizes)
+                runCase(DefaultSampleRate, blockSize, DefaultChannels, BandStates[0]);
+
+            for (auto sampleRate : SampleRates)
+                if (sampleRate != DefaultSampleRate)
+                    runCase(sampleRate, DefaultBlockSize, DefaultChannels, BandStates[0]);
+
+            for (auto numChannels : ChannelCounts)
+                if (numChannels != DefaultChannels)
+                    runCase(DefaultSampleRate, DefaultBlockSize, numChannels, BandStates[0]);
+
+            for (size_t i = 1; i < BandStates.size(); ++i)
+                runCase(DefaultSampleRate, DefaultBlockSize, DefaultChannels, BandStates[i]);
+        }
+
+        //the linear-phase crossover over the block sizes, its convolutions care most about how they're fed
+        for (auto blockSize : BlockSizes)
+        {
+            results.push_back(benchProcessBlock(processor, DefaultSampleRate, blockSize, DefaultChannels, BandStates[0], true));
+            print(results.back());
+        }
+
+        //the stages on their own, at the default rate and width
+        for (auto blockSize : BlockSizes)
+        {
+            auto first = results.size();
+            benchStages(processor, blockSize, results);
+
+            for (auto i = first; i < results.size(); ++i)
+                print(results[i]);
+        }
+
+        for (auto sampleRate : { 44100.0, 96000.0, 192000.0 })
+        {
+            auto first = results.size();
+            benchDetector(sampleRate, DefaultBlockSize, results);
+
+            for (auto i = first; i < results.size(); ++i)
+                print(results[i]);
+        }
+
+        if (args.containsOption("--out"))
+        {
+            auto outputFile = args.getFileForOption("--out");
+            if (! outputFile.replaceWithText(juce::JSON::toString(toJson(results))))
+                juce::ConsoleApplication::fail("couldn't write " + outputFile.getFullPathName());
+        }
+
+        if (args.containsOption("--baseline"))
+        {
+            auto baseline = juce::JSON::parse(args.getExistingFileForOption("--baseline"));
+            auto tolerance = args.containsOption("--tolerance") ? args.getValueForOption("--tolerance").getDoubleValue() : 5.0;
+
+            if (compareWithBaseline(results, baseline, tolerance) > 0)
+                return 1;
+        }
+
+        return 0;
+    });
+}
@@ -0,0 +1,577 @@
+/*
+  ==============================================================================
+
+    RealtimeCheck.cpp
+    Created: 17 Oct 2026 9:52:10pm
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#include "RealtimeCheck.h"
+#include <iostream>
+#include <new>
+#include <thread>
+#include "../PluginProcessor.h"
+#include "../DSP/BandWorkerPool.h"
+#include "../DSP/Fifo.h"
+
+#if JUCE_LINUX
+ #include <dlfcn.h>
+ #include <pthread.h>
+#endif
+
+/*
+ The hooks replace the global operator new/delete family everywhere. On Linux malloc/free and
+ the pthread lock calls are interposed as well, which matters because juce::HeapBlock (and with
+ it AudioBuffer) allocates with std::malloc rather than new.
+
+ A hook only reports while the calling thread is inside a RealtimeScope, or is running band
+ jobs for a BandWorkerPool while any scope is open. An idle worker waiting for its next batch
+ isn't on the audio path, so what it locks while parked doesn't count. Reporting itself allocates (the stack trace, the map),
+ so it raises hookDepth first and nothing it does gets reported back.
+ */
+namespace
+{
+    //plain thread_locals, no constructors, so they are safe to touch from inside malloc
+    thread_local int realtimeDepth = 0;
+    thread_local int hookDepth = 0;
+
+    std::atomic<int> openScopes{ 0 };
+
+    struct Violation
+    {
+        juce::String kind, stackTrace;
+        int count{ 0 };
+    };
+
+    juce::SpinLock violationsLock;
+    std::map<juce::String, Violation>* violations = nullptr;
+    std::atomic<int> totalViolations{ 0 };
+
+    constexpr size_t MaxDistinctViolations = 64;
+
+    bool shouldReport()
+    {
+        if (hookDepth > 0)
+            return false;
+
+        if (realtimeDepth > 0)
+            return true;
+
+        return openScopes.load(std::memory_order_relaxed) > 0 && BandWorkerPool::isRunningJobs();
+    }
+
+    void report(const char* kind)
+    {
+        if (! shouldReport())
+            return;
+
+        ++hookDepth;
+        ++totalViolations;
+
+        //scoped so the strings are freed before hookDepth drops again
+        {
+            auto stackTrace = juce::SystemStats::getStackBacktrace();
+            auto key = juce::String(kind) + "\n" + stackTrace;
+
+            const juce::SpinLock::ScopedLockType lock(violationsLock);
+
+            if (violations != nullptr)
+            {
+                auto found = violations->find(key);
+                if (found != violations->end())
+                    ++found->second.count;
+                else if (violations->size() < MaxDistinctViolations)
+                    violations->emplace(key, Violation{ kind, stackTrace, 1 });
+            }
+        }
+
+        --hookDepth;
+    }
+
+    /** marks the calling thread as the audio thread for as long as it lives */
+    struct RealtimeScope
+    {
+        RealtimeScope() { ++realtimeDepth; ++openScopes; }
+        ~RealtimeScope() { --openScopes; --realtimeDepth; }
+    };
+
+    /** collects what the hooks report for as long as it lives, then prints it */
+    struct ViolationLog
+    {
+        ViolationLog()
+        {
+            const juce::SpinLock::ScopedLockType lock(violationsLock);
+            violations = &found;
+            totalViolations = 0;
+        }
+
+        ~ViolationLog()
+        {
+            const juce::SpinLock::ScopedLockType lock(violationsLock);
+            violations = nullptr;
+        }
+
+        /** prints every call site and returns the total */
+        int print(const char* where)
+        {
+            {
+                const juce::SpinLock::ScopedLockType lock(violationsLock);
+                violations = nullptr;
+            }
+
+            for (const auto& [key, violation] : found)
+            {
+                std::cout << std::endl << violation.kind << " " << where << ", " << violation.count << "x" << std::endl
+                          << violation.stackTrace << std::endl;
+            }
+
+            const auto total = totalViolations.load();
+            std::cout << (total == 0 ? juce::String("clean") : juce::String(total) + " violations at " + juce::String(static_cast<int>(found.size())) + " call sites")
+                      << std::endl;
+
+            return total;
+        }
+
+        std::map<juce::String, Violation> found;
+    };
+
+    void* allocate(std::size_t size, const char* kind)
+    {
+        report(kind);
+
+        ++hookDepth;
+        auto* memory = std::malloc(size == 0 ? 1 : size);
+        --hookDepth;
+
+        return memory;
+    }
+
+    void* allocateAligned(std::size_t size, std::align_val_t alignment, const char* kind)
+    {
+        report(kind);
+
+        const auto align = juce::jmax(static_cast<std::size_t>(alignment), sizeof(void*));
+        void* memory = nullptr;
+
+        ++hookDepth;
+       #if JUCE_WINDOWS
+        memory = _aligned_malloc(size == 0 ? 1 : size, align);
+       #else
+        if (posix_memalign(&memory, align, size == 0 ? 1 : size) != 0)
+            memory = nullptr;
+       #endif
+        --hookDepth;
+
+        return memory;
+    }
+
+    void release(void* memory, const char* kind)
+    {
+        if (memory == nullptr)
+            return;
+
+        report(kind);
+
+        ++hookDepth;
+        std::free(memory);
+        --hookDepth;
+    }
+
+    void releaseAligned(void* memory, const char* kind)
+    {
+        if (memory == nullptr)
+            return;
+
+        report(kind);
+
+        ++hookDepth;
+       #if JUCE_WINDOWS
+        _aligned_free(memory);
+       #else
+        std::free(memory);
+       #endif
+        --hookDepth;
+    }
+}
+
+//==============================================================================
+void* operator new(std::size_t size)
+{
+    if (auto* memory = allocate(size, "operator new"))
+        return memory;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    if (auto* memory = allocate(size, "operator new[]"))
+        return memory;
+
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return allocate(size, "operator new"); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return allocate(size, "operator new[]"); }
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    if (auto* memory = allocateAligned(size, alignment, "aligned operator new"))
+        return memory;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    if (auto* memory = allocateAligned(size, alignment, "aligned operator new[]"))
+        return memory;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept { release(memory, "operator delete"); }
+void operator delete[](void* memory) noexcept { release(memory, "operator delete[]"); }
+void operator delete(void* memory, std::size_t) noexcept { release(memory, "operator delete"); }
+void operator delete[](void* memory, std::size_t) noexcept { release(memory, "operator delete[]"); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { release(memory, "operator delete"); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { release(memory, "operator delete[]"); }
+void operator delete(void* memory, std::align_val_t) noexcept { releaseAligned(memory, "aligned operator delete"); }
+void operator delete[](void* memory, std::align_val_t) noexcept { releaseAligned(memory, "aligned operator delete[]"); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { releaseAligned(memory, "aligned operator delete"); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept { releaseAligned(memory, "aligned operator delete[]"); }
+
+#if JUCE_LINUX
+//==============================================================================
+namespace
+{
+    /**
+     the real lock function behind ours. Not a function-local static: its init guard can take a
+     mutex itself. Racing lookups all store the same pointer.
+     */
+    template <typename Fn>
+    Fn findNext(std::atomic<void*>& cache, const char* name)
+    {
+        auto* fn = cache.load(std::memory_order_relaxed);
+
+        if (fn == nullptr)
+        {
+            ++hookDepth;
+            fn = dlsym(RTLD_NEXT, name);
+            --hookDepth;
+            cache.store(fn, std::memory_order_relaxed);
+        }
+
+        return reinterpret_cast<Fn>(fn);
+    }
+
+    std::atomic<void*> nextMutexLock{ nullptr }, nextReadLock{ nullptr }, nextWriteLock{ nullptr };
+}
+
+extern "C"
+{
+    void* __libc_malloc(size_t) noexcept;
+    void* __libc_calloc(size_t, size_t) noexcept;
+    void* __libc_realloc(void*, size_t) noexcept;
+    void __libc_free(void*) noexcept;
+
+    void* malloc(size_t size) noexcept
+    {
+        report("malloc");
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t count, size_t size) noexcept
+    {
+        report("calloc");
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* memory, size_t size) noexcept
+    {
+        report("realloc");
+        return __libc_realloc(memory, size);
+    }
+
+    void free(void* memory) noexcept
+    {
+        if (memory != nullptr)
+            report("free");
+
+        __libc_free(memory);
+    }
+
+    int pthread_mutex_lock(pthread_mutex_t* mutex) noexcept
+    {
+        report("pthread_mutex_lock");
+        return findNext<int (*)(pthread_mutex_t*)>(nextMutexLock, "pthread_mutex_lock")(mutex);
+    }
+
+    int pthread_rwlock_rdlock(pthread_rwlock_t* lock) noexcept
+    {
+        report("pthread_rwlock_rdlock");
+        return findNext<int (*)(pthread_rwlock_t*)>(nextReadLock, "pthread_rwlock_rdlock")(lock);
+    }
+
+    int pthread_rwlock_wrlock(pthread_rwlock_t* lock) noexcept
+    {
+        report("pthread_rwlock_wrlock");
+        return findNext<int (*)(pthread_rwlock_t*)>(nextWriteLock, "pthread_rwlock_wrlock")(lock);
+    }
+}
+#endif
+
+//==============================================================================
+namespace
+{
+    const std::array<double, 5> HostSampleRates{ 44100.0, 48000.0, 88200.0, 96000.0, 192000.0 };
+    const std::array<int, 6> HostBlockSizes{ 32, 64, 128, 512, 1024, 4096 };
+    const std::array<int, 4> HostChannelCounts{ 1, 2, 6, 16 };
+
+    struct Host
+    {
+        SimpleMBCompAudioProcessor processor;
+        juce::Random random;
+
+        std::vector<juce::MemoryBlock> states;
+        juce::AudioBuffer<float> floatBuffer;
+        juce::AudioBuffer<double> doubleBuffer;
+        juce::MidiBuffer midi;
+        int maxBlockSize{ 0 };
+
+        explicit Host(juce::int64 seed) : random(seed)
+        {
+            //a handful of random presets to load between blocks
+            for (int i = 0; i < 8; ++i)
+            {
+                randomiseParameters(1.f);
+                states.emplace_back();
+                processor.getStateInformation(states.back());
+            }
+        }
+
+        void randomiseParameters(float probability)
+        {
+            for (auto* parameter : processor.getParameters())
+                if (random.nextFloat() < probability)
+                    parameter->setValueNotifyingHost(random.nextFloat());
+        }
+
+        /** releaseResources, a new layout, precision, rate and block size, then prepareToPlay */
+        void reprepare()
+        {
+            processor.releaseResources();
+
+            const auto numChannels = HostChannelCounts[static_cast<size_t>(random.nextInt(static_cast<int>(HostChannelCounts.size())))];
+            auto layout = processor.getBusesLayout();
+            layout.inputBuses.getReference(0) = juce::AudioChannelSet::canonicalChannelSet(numChannels);
+            layout.outputBuses.getReference(0) = juce::AudioChannelSet::canonicalChannelSet(numChannels);
+            if (layout.inputBuses.size() > 1)
+                layout.inputBuses.getReference(1) = random.nextBool() ? juce::AudioChannelSet::stereo() : juce::AudioChannelSet::disabled();
+
+            auto layoutApplied = processor.setBusesLayout(layout);
+            jassert(layoutApplied);
+            juce::ignoreUnused(layoutApplied);
+
+            processor.setProcessingPrecision(random.nextBool() ? juce::AudioProcessor::doublePrecision
+                                                               : juce::AudioProcessor::singlePrecision);
+
+            maxBlockSize = HostBlockSizes[static_cast<size_t>(random.nextInt(static_cast<int>(HostBlockSizes.size())))];
+            processor.prepareToPlay(HostSampleRates[static_cast<size_t>(random.nextInt(static_cast<int>(HostSampleRates.size())))], maxBlockSize);
+
+            const auto totalChannels = juce::jmax(processor.getTotalNumInputChannels(), processor.getTotalNumOutputChannels());
+            floatBuffer.setSize(totalChannels, maxBlockSize);
+            doubleBuffer.setSize(totalChannels, maxBlockSize);
+        }
+
+        template <typename SampleType>
+        void processRandomBlock(juce::AudioBuffer<SampleType>& buffer)
+        {
+            //hosts hand over anything up to the prepared size, including odd lengths
+            const auto numSamples = 1 + random.nextInt(maxBlockSize);
+            const auto gain = random.nextFloat() < 0.1f ? 0.f : random.nextFloat();
+
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                for (int i = 0; i < numSamples; ++i)
+                    buffer.setSample(ch, i, static_cast<SampleType>(gain * (2.f * random.nextFloat() - 1.f)));
+
+            juce::AudioBuffer<SampleType> block(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), numSamples);
+
+            std::array<std::pair<juce::AudioProcessorParameter*, float>, 4> automation;
+            const auto numAutomated = random.nextInt(static_cast<int>(automation.size()) + 1);
+            auto& parameters = processor.getParameters();
+            for (int i = 0; i < numAutomated; ++i)
+                automation[static_cast<size_t>(i)] = { parameters[random.nextInt(parameters.size())], random.nextFloat() };
+
+            RealtimeScope scope;
+
+            //plugin hosts deliver automation on the audio thread, just ahead of the block
+            for (int i = 0; i < numAutomated; ++i)
+                automation[static_cast<size_t>(i)].first->setValue(automation[static_cast<size_t>(i)].second);
+
+            processor.processBlock(block, midi);
+        }
+
+        void step()
+        {
+            const auto event = random.nextFloat();
+
+            if (event < 0.01f)
+                reprepare();
+            else if (event < 0.02f)
+            {
+                const auto& state = states[static_cast<size_t>(random.nextInt(static_cast<int>(states.size())))];
+                processor.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+            }
+
+            if (processor.isUsingDoublePrecision())
+                processRandomBlock(doubleBuffer);
+            else
+                processRandomBlock(floatBuffer);
+        }
+    };
+}
+
+int runRealtimeCheck(const juce::ArgumentList& args)
+{
+    const auto numBlocks = args.containsOption("--blocks") ? args.getValueForOption("--blocks").getIntValue() : 20000;
+    const auto seed = args.containsOption("--seed") ? args.getValueForOption("--seed").getLargeIntValue() : juce::Time::currentTimeMillis();
+
+    ViolationLog log;
+    std::cout << "realtime check, " << numBlocks << " blocks, seed " << seed << std::endl;
+
+    {
+        Host host(seed);
+        host.reprepare();
+
+        for (int i = 0; i < numBlocks; ++i)
+            host.step();
+    }
+
+    return log.print("on the audio thread") == 0 ? 0 : 1;
+}
+
+//==============================================================================
+namespace
+{
+    constexpr int FifoCheckSamples = 512;
+
+    struct FifoCheckResult
+    {
+        juce::uint64 numRead{ 0 }, numTorn{ 0 }, numOutOfOrder{ 0 };
+        juce::uint64 numDropped{ 0 }, numOverwritten{ 0 };
+    };
+
+    /**
+     A writer stamps every sample of a slot with the item's number while a reader checks that each
+     slot it gets holds a single number, larger than the last one. The reader holds on to some
+     slots for a while and yields between others, so the writer keeps running into a full ring.
+     */
+    FifoCheckResult runFifoPolicy(FullPolicy policy, int numItems, juce::int64 seed)
+    {
+        Fifo<juce::AudioBuffer<float>> fifo(policy);
+        fifo.prepare([](juce::AudioBuffer<float>& buffer) { buffer.setSize(1, FifoCheckSamples); buffer.clear(); });
+
+        FifoCheckResult result;
+        std::atomic<bool> writerDone{ false };
+
+        std::thread writer([&]
+        {
+            RealtimeScope scope;
+
+            for (int item = 1; item <= numItems; ++item)
+            {
+                if (auto* slot = fifo.beginWrite())
+                {
+                    juce::FloatVectorOperations::fill(slot->getWritePointer(0), static_cast<float>(item), FifoCheckSamples);
+                    fifo.finishWrite();
+                }
+            }
+
+            writerDone.store(true);
+        });
+
+        std::thread reader([&]
+        {
+            RealtimeScope scope;
+            juce::Random random(seed);
+            float lastItem = 0;
+
+            auto check = [&](const juce::AudioBuffer<float>& slot)
+            {
+                const auto* samples = slot.getReadPointer(0);
+                const auto item = samples[0];
+
+                //dawdle inside the slot now and then, so the writer tries to overwrite it
+                if (random.nextInt(16) == 0)
+                    std::this_thread::yield();
+
+                if (juce::FloatVectorOperations::findMinAndMax(samples, FifoCheckSamples) != juce::Range<float>(item, item))
+                    ++result.numTorn;
+
+                if (item <= lastItem)
+                    ++result.numOutOfOrder;
+
+                lastItem = item;
+                ++result.numRead;
+            };
+
+            for (;;)
+            {
+                //read the done flag first, so nothing published before it can be missed
+                const auto done = writerDone.load();
+
+                if (! fifo.read(check))
+                {
+                    if (done)
+                        break;
+
+                    std::this_thread::yield();
+                }
+                else if (random.nextInt(64) == 0)
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        writer.join();
+        reader.join();
+
+        result.numDropped = fifo.getNumDropped();
+        result.numOverwritten = fifo.getNumOverwritten();
+        return result;
+    }
+}
+
+int runFifoCheck(const juce::ArgumentList& args)
+{
+    //the stamps are floats, which count exactly up to 2^24
+    const auto numItems = juce::jlimit(1, 1 << 24, args.containsOption("--items") ? args.getValueForOption("--items").getIntValue() : 1000000);
+    const auto seed = args.containsOption("--seed") ? args.getValueForOption("--seed").getLargeIntValue() : juce::Time::currentTimeMillis();
+
+    ViolationLog log;
+    std::cout << "fifo check, " << numItems << " items per policy, seed " << seed << std::endl;
+
+    auto failed = false;
+
+    for (auto policy : { FullPolicy::DropNewest, FullPolicy::OverwriteOldest })
+    {
+        const auto result = runFifoPolicy(policy, numItems, seed);
+
+        //every item is either read, dropped by the writer or overwritten before it was read
+        const auto accounted = result.numRead + result.numDropped + result.numOverwritten;
+        const auto ok = result.numTorn == 0 && result.numOutOfOrder == 0 && accounted == static_cast<juce::uint64>(numItems);
+        failed = failed || ! ok;
+
+        std::cout << (policy == FullPolicy::DropNewest ? "drop newest:      " : "overwrite oldest: ")
+                  << result.numRead << " read, " << result.numDropped << " dropped, " << result.numOverwritten << " overwritten, "
+                  << result.numTorn << " torn, " << result.numOutOfOrder << " out of order"
+                  << (ok ? "" : "   <-- failed") << std::endl;
+    }
+
+    const auto numViolations = log.print("in the writer or reader");
+    return failed || numViolations > 0 ? 1 : 0;
+}
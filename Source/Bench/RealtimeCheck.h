@@ -0,0 +1,35 @@
+/*
+  ==============================================================================
+
+    RealtimeCheck.h
+    Created: 17 Oct 2026 9:52:10pm
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+ Drives the processor the way an unfriendly host would and reports anything on the audio
+ thread that can block: heap allocations and frees, and (on Linux) mutex/rwlock acquisition.
+
+     SimpleMBCompBench --rtcheck [--blocks N] [--seed N]
+
+ Returns 0 when processBlock stayed clean, 1 otherwise. Every distinct call site is printed
+ with a stack trace and how often it was hit.
+ */
+int runRealtimeCheck(const juce::ArgumentList& args);
+
+/*
+ Stress test for the Fifo the analyzer uses. A writer and a reader thread hammer one ring per
+ full policy, with the same allocation and lock traps on both, and every slot the reader gets
+ is checked for a torn or out-of-order write.
+
+     SimpleMBCompBench --fifocheck [--items N] [--seed N]
+
+ Returns 0 when every item was read, dropped or overwritten exactly once, none was torn and
+ neither side allocated or locked.
+ */
+int runFifoCheck(const juce::ArgumentList& args);
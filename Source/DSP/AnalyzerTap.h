@@ -0,0 +1,130 @@
+/*
+  ==============================================================================
+
+    AnalyzerTap.h
+    Created: 18 Oct 2026 1:02:37am
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+enum Channel
+{
+    Right, //effectively 0
+    Left //effectively 1
+};
+
+/*
+ What the spectrum analyzer gets to see of the audio, both channels, in one planar ring.
+
+ The audio thread copies each block in with at most two contiguous copies per channel and
+ publishes it with a single store of the write count. Each analyzer channel is read at its own
+ pace, so there's a read count per channel, and a block that doesn't fit behind the slower of
+ the two is dropped whole. That's also what keeps the tap nearly free while the editor is
+ closed: once the ring has filled up, a block costs two atomic loads and a compare.
+ */
+struct AnalyzerTap
+{
+    static constexpr int NumChannels = 2;
+
+    //~0.7s at 48kHz, so even 192kHz survives a few late editor frames
+    static constexpr int Capacity = 1 << 15;
+
+    AnalyzerTap()
+    {
+        for (auto& channel : rings)
+            channel.resize(static_cast<size_t>(Capacity), 0.f);
+    }
+
+    /** audio thread, once per block. Takes float or double buffers, the analyzer side is always float. */
+    template <typename SampleType>
+    void push(const juce::AudioBuffer<SampleType>& buffer)
+    {
+        const auto numSamples = buffer.getNumSamples();
+        const auto numSourceChannels = buffer.getNumChannels();
+        jassert(numSourceChannels > 0);
+
+        if (numSamples == 0 || numSourceChannels == 0)
+            return;
+
+        const auto written = writeCount.load(std::memory_order_relaxed);
+        const auto unread = juce::jmax(written - readCounts[0].load(std::memory_order_acquire),
+                                       written - readCounts[1].load(std::memory_order_acquire));
+
+        if (static_cast<juce::uint32>(numSamples) > static_cast<juce::uint32>(Capacity) - unread)
+            return;
+
+        const auto start = static_cast<int>(written & Mask);
+        const auto firstSpan = juce::jmin(numSamples, Capacity - start);
+
+        for (int ch = 0; ch < NumChannels; ++ch)
+        {
+            //a mono bus feeds both analyzer channels
+            const auto* source = buffer.getReadPointer(juce::jmin(ch, numSourceChannels - 1));
+            auto* ring = rings[static_cast<size_t>(ch)].data();
+
+            copy(source, ring + start, firstSpan);
+            copy(source + firstSpan, ring, numSamples - firstSpan);
+        }
+
+        writeCount.store(written + static_cast<juce::uint32>(numSamples), std::memory_order_release);
+    }
+
+    //==============================================================================
+    /** editor, samples of one channel that haven't been pulled yet */
+    int getNumReady(Channel channel) const
+    {
+        const auto read = readCounts[static_cast<size_t>(channel)].load(std::memory_order_relaxed);
+        return static_cast<int>(writeCount.load(std::memory_order_acquire) - read);
+    }
+
+    /** editor, copies up to maxSamples of one channel oldest first and returns how many */
+    int pull(Channel channel, float* dest, int maxSamples)
+    {
+        auto& readCount = readCounts[static_cast<size_t>(channel)];
+        const auto read = readCount.load(std::memory_order_relaxed);
+        const auto numSamples = juce::jmin(maxSamples, getNumReady(channel));
+
+        const auto start = static_cast<int>(read & Mask);
+        const auto firstSpan = juce::jmin(numSamples, Capacity - start);
+        const auto* ring = rings[static_cast<size_t>(channel)].data();
+
+        copy(ring + start, dest, firstSpan);
+        copy(ring, dest + firstSpan, numSamples - firstSpan);
+
+        readCount.store(read + static_cast<juce::uint32>(numSamples), std::memory_order_release);
+        return numSamples;
+    }
+
+    /** editor, throws away up to numSamples of one channel without reading them */
+    void skip(Channel channel, int numSamples)
+    {
+        auto& readCount = readCounts[static_cast<size_t>(channel)];
+        const auto numSkipped = juce::jlimit(0, getNumReady(channel), numSamples);
+        readCount.store(readCount.load(std::memory_order_relaxed) + static_cast<juce::uint32>(numSkipped), std::memory_order_release);
+    }
+private:
+    static constexpr juce::uint32 Mask = static_cast<juce::uint32>(Capacity - 1);
+
+    std::array<std::vector<float>, NumChannels> rings;
+
+    //free-running sample counts, they wrap together
+    std::atomic<juce::uint32> writeCount{ 0 };
+    std::array<std::atomic<juce::uint32>, NumChannels> readCounts{};
+
+    template <typename SourceType>
+    static void copy(const SourceType* source, float* dest, int numSamples)
+    {
+        if (numSamples <= 0)
+            return;
+
+        if constexpr (std::is_same_v<SourceType, float>)
+            std::memcpy(dest, source, sizeof(float) * static_cast<size_t>(numSamples));
+        else
+            for (int i = 0; i < numSamples; ++i)
+                dest[i] = static_cast<float>(source[i]);
+    }
+};
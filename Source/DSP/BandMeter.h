@@ -0,0 +1,276 @@
+/*
+  ==============================================================================
+
+    BandMeter.h
+    Created: 17 Oct 2026 11:52:37pm
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+ Sum of squares and sample peak of whatever samples go through it, for loops that pass over a
+ block anyway (the compressor's envelope and gain loops) to hand to BandMeter::update().
+ */
+template <typename SampleType>
+struct BlockLevels
+{
+    using Register = juce::dsp::SIMDRegister<SampleType>;
+    static constexpr int Lanes = static_cast<int>(Register::size());
+
+    void add(Register x)
+    {
+        sumSquares += x * x;
+        peak = Register::max(peak, Register::abs(x));
+    }
+
+    void add(SampleType x)
+    {
+        tailSquares += x * x;
+        tailPeak = juce::jmax(tailPeak, std::abs(x));
+    }
+
+    void add(const SampleType* samples, int numSamples)
+    {
+        const auto vectorEnd = numSamples - numSamples % Lanes;
+
+        for (int i = 0; i < vectorEnd; i += Lanes)
+            add(load(samples + i));
+
+        for (int i = vectorEnd; i < numSamples; ++i)
+            add(samples[i]);
+    }
+
+    SampleType getSumSquares() const { return sumSquares.sum() + tailSquares; }
+
+    SampleType getPeak() const
+    {
+        auto result = tailPeak;
+        for (size_t lane = 0; lane < Register::size(); ++lane)
+            result = juce::jmax(result, peak.get(lane));
+
+        return result;
+    }
+
+    /** channel pointers of sub-blocks aren't SIMD-aligned, so these are unaligned */
+    static Register load(const SampleType* samples)
+    {
+        Register x;
+        std::memcpy(&x, samples, sizeof(Register));
+        return x;
+    }
+
+    static void store(SampleType* samples, Register x)
+    {
+        std::memcpy(samples, &x, sizeof(Register));
+    }
+private:
+    Register sumSquares = Register::expand(SampleType(0)), peak = Register::expand(SampleType(0));
+    SampleType tailSquares = 0, tailPeak = 0;
+};
+
+/*
+ RMS, sample peak and (optionally) 4x oversampled true peak of a block, from a single pass over
+ each channel. update() takes levels some other loop has already gathered instead.
+
+ The RMS is the mean power over every channel, so a hard-panned signal reads the same as it
+ would in any other meter, not the average of per-channel RMS values. Both readings get
+ ballistics: RMS is a one-pole average of the power with the given window, and the peak
+ holds, then falls at a fixed rate in dB per second.
+
+ The audio thread (or the band worker) measures, the editor reads the atomics.
+ */
+template <typename SampleType>
+struct BandMeter
+{
+    static constexpr int MaxChannels = 16;
+
+    void prepare(double newSampleRate, int newNumChannels, int maxBlockSize)
+    {
+        jassert(newNumChannels <= MaxChannels);
+
+        sampleRate = newSampleRate;
+        numChannels = juce::jmin(newNumChannels, MaxChannels);
+
+        //room for the filter history in front of the block
+        truePeakScratch.resize(static_cast<size_t>(maxBlockSize + TapsPerPhase - 1));
+        interpolator = makeInterpolator();
+
+        reset();
+    }
+
+    void reset()
+    {
+        smoothedPower = 0;
+        heldPeak = 0;
+        heldTruePeak = 0;
+
+        for (auto& history : truePeakHistory)
+            history.fill(SampleType(0));
+
+        power.store(0.f);
+        peak.store(0.f);
+        truePeak.store(0.f);
+    }
+
+    void setBallistics(float rmsWindowMs, float peakReleaseDbPerSec)
+    {
+        rmsWindowSeconds = juce::jmax(rmsWindowMs, 1.f) * 0.001;
+        peakReleaseDbPerSecond = juce::jmax(peakReleaseDbPerSec, 0.f);
+    }
+
+    /** the 4x interpolation costs about as much as the rest of the band's metering together */
+    void setTruePeakEnabled(bool shouldMeasureTruePeak)
+    {
+        if (truePeakEnabled == shouldMeasureTruePeak)
+            return;
+
+        truePeakEnabled = shouldMeasureTruePeak;
+        reset();
+    }
+
+    bool isTruePeakEnabled() const { return truePeakEnabled; }
+
+    void measure(const juce::dsp::AudioBlock<const SampleType>& block)
+    {
+        const auto numSamples = static_cast<int>(block.getNumSamples());
+        const auto channels = juce::jmin(static_cast<int>(block.getNumChannels()), numChannels);
+
+        if (numSamples == 0 || channels == 0)
+            return;
+
+        BlockLevels<SampleType> levels;
+        SampleType blockTruePeak = 0;
+
+        for (int ch = 0; ch < channels; ++ch)
+        {
+            const auto* samples = block.getChannelPointer(static_cast<size_t>(ch));
+            levels.add(samples, numSamples);
+
+            if (truePeakEnabled)
+                blockTruePeak = juce::jmax(blockTruePeak, measureTruePeak(ch, samples, numSamples));
+        }
+
+        update(levels, numSamples, channels);
+
+        if (truePeakEnabled)
+        {
+            //the interpolated peak can't be below the samples it went through
+            const auto samplePeak = levels.getPeak();
+            heldTruePeak = juce::jmax(static_cast<double>(juce::jmax(blockTruePeak, samplePeak)), heldTruePeak * getPeakDecay(numSamples));
+            truePeak.store(static_cast<float>(heldTruePeak));
+        }
+    }
+
+    /** levels of numChannels x numSamples gathered elsewhere, true peak is left alone */
+    void update(const BlockLevels<SampleType>& levels, int numSamples, int channels)
+    {
+        if (numSamples == 0 || channels == 0)
+            return;
+
+        //ballistics are applied per block, their constants scale with its length
+        const auto meanPower = static_cast<double>(levels.getSumSquares()) / (static_cast<double>(numSamples) * channels);
+        const auto alpha = 1.0 - std::exp(-numSamples / (rmsWindowSeconds * sampleRate));
+        smoothedPower += alpha * (meanPower - smoothedPower);
+
+        heldPeak = juce::jmax(static_cast<double>(levels.getPeak()), heldPeak * getPeakDecay(numSamples));
+
+        power.store(static_cast<float>(smoothedPower));
+        peak.store(static_cast<float>(heldPeak));
+    }
+
+    float getRMSDb() const { return juce::Decibels::gainToDecibels(std::sqrt(power.load())); }
+    float getPeakDb() const { return juce::Decibels::gainToDecibels(peak.load()); }
+
+    /** -inf while true peak metering is off */
+    float getTruePeakDb() const { return juce::Decibels::gainToDecibels(truePeak.load()); }
+private:
+    //4x polyphase interpolator, 48 taps like the BS.1770 reference filter
+    static constexpr int Phases = 4;
+    static constexpr int TapsPerPhase = 12;
+
+    double sampleRate = 44100.0;
+    int numChannels = 0;
+
+    double rmsWindowSeconds = 0.3;
+    double peakReleaseDbPerSecond = 12.0;
+    bool truePeakEnabled = false;
+
+    double smoothedPower = 0, heldPeak = 0, heldTruePeak = 0;
+    std::atomic<float> power{ 0.f }, peak{ 0.f }, truePeak{ 0.f };
+
+    std::array<std::array<SampleType, TapsPerPhase - 1>, MaxChannels> truePeakHistory{};
+    std::vector<SampleType> truePeakScratch;
+    std::array<std::array<SampleType, TapsPerPhase>, Phases> interpolator{};
+
+    double getPeakDecay(int numSamples) const
+    {
+        return juce::Decibels::decibelsToGain(-peakReleaseDbPerSecond * numSamples / sampleRate);
+    }
+
+    SampleType measureTruePeak(int channel, const SampleType* samples, int numSamples)
+    {
+        //history followed by the block, so every output sees TapsPerPhase contiguous inputs
+        auto& history = truePeakHistory[static_cast<size_t>(channel)];
+        auto* scratch = truePeakScratch.data();
+        jassert(static_cast<size_t>(numSamples + TapsPerPhase - 1) <= truePeakScratch.size());
+
+        std::copy(history.begin(), history.end(), scratch);
+        std::copy(samples, samples + numSamples, scratch + history.size());
+
+        SampleType result = 0;
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto* window = scratch + i;
+
+            for (int phase = 0; phase < Phases; ++phase)
+            {
+                const auto* taps = interpolator[static_cast<size_t>(phase)].data();
+
+                SampleType y = 0;
+                for (int tap = 0; tap < TapsPerPhase; ++tap)
+                    y += taps[tap] * window[tap];
+
+                result = juce::jmax(result, std::abs(y));
+            }
+        }
+
+        std::copy(scratch + numSamples, scratch + numSamples + history.size(), history.begin());
+        return result;
+    }
+
+    /** Hann-windowed sinc, each phase normalised to unity gain at DC and stored oldest tap first */
+    static std::array<std::array<SampleType, TapsPerPhase>, Phases> makeInterpolator()
+    {
+        constexpr auto NumTaps = Phases * TapsPerPhase;
+        const auto centre = (NumTaps - 1) * 0.5;
+
+        std::array<std::array<SampleType, TapsPerPhase>, Phases> phases{};
+
+        for (int phase = 0; phase < Phases; ++phase)
+        {
+            double sum = 0;
+            std::array<double, TapsPerPhase> taps{};
+
+            for (int k = 0; k < TapsPerPhase; ++k)
+            {
+                auto n = phase + k * Phases;
+                auto t = (n - centre) / Phases;
+                auto sinc = std::abs(t) < 1.0e-9 ? 1.0 : std::sin(juce::MathConstants<double>::pi * t) / (juce::MathConstants<double>::pi * t);
+                auto window = 0.5 - 0.5 * std::cos(juce::MathConstants<double>::twoPi * (n + 0.5) / NumTaps);
+
+                taps[static_cast<size_t>(k)] = sinc * window;
+                sum += taps[static_cast<size_t>(k)];
+            }
+
+            //tap k multiplies the input k samples back, the window runs oldest to newest
+            for (int k = 0; k < TapsPerPhase; ++k)
+                phases[static_cast<size_t>(phase)][static_cast<size_t>(TapsPerPhase - 1 - k)] = static_cast<SampleType>(taps[static_cast<size_t>(k)] / sum);
+        }
+
+        return phases;
+    }
+};
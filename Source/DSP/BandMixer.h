@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+
+    BandMixer.h
+    Created: 17 Oct 2026 10:03:18am
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+ Sums the compressed bands back into the output and applies the output gain in
+ the same loop. Solo/mute is passed in as a per-band gain mask (1 = audible, 0 = silent)
+ that gets folded into the band gains, so the output is only written once per block.
+ */
+template <typename SampleType, size_t NumBands>
+struct BandMixer
+{
+    void prepare(const juce::dsp::ProcessSpec& spec)
+    {
+        sampleRate = spec.sampleRate;
+        gainRamp.assign(spec.maximumBlockSize, SampleType(0));
+
+        reset();
+    }
+
+    void reset()
+    {
+        if (sampleRate > 0)
+            gain.reset(sampleRate, rampDurationSeconds);
+    }
+
+    void setGainDecibels(float newGainDecibels)
+    {
+        gain.setTargetValue(juce::Decibels::decibelsToGain(static_cast<SampleType>(newGainDecibels)));
+    }
+
+    void setRampDurationSeconds(double newDurationSeconds)
+    {
+        if (rampDurationSeconds != newDurationSeconds)
+        {
+            rampDurationSeconds = newDurationSeconds;
+            reset();
+        }
+    }
+
+    void process(juce::AudioBuffer<SampleType>& output,
+                 const std::array<juce::AudioBuffer<SampleType>, NumBands>& bands,
+                 const std::array<float, NumBands>& bandMask)
+    {
+        const auto numSamples = output.getNumSamples();
+        auto numChannels = output.getNumChannels();
+        for (const auto& band : bands)
+        {
+            jassert(band.getNumSamples() == numSamples);
+            numChannels = juce::jmin(numChannels, band.getNumChannels());
+        }
+
+        //channels without a band behind them would otherwise keep the dry input
+        for (auto ch = numChannels; ch < output.getNumChannels(); ++ch)
+            output.clear(ch, 0, numSamples);
+
+        const auto isRamping = gain.isSmoothing();
+        std::array<SampleType, NumBands> bandGains;
+
+        if (isRamping)
+        {
+            jassert(static_cast<size_t>(numSamples) <= gainRamp.size());
+            for (int i = 0; i < numSamples; ++i)
+                gainRamp[static_cast<size_t>(i)] = gain.getNextValue();
+
+            for (size_t band = 0; band < NumBands; ++band)
+                bandGains[band] = static_cast<SampleType>(bandMask[band]);
+        }
+        else
+        {
+            for (size_t band = 0; band < NumBands; ++band)
+                bandGains[band] = static_cast<SampleType>(bandMask[band]) * gain.getTargetValue();
+        }
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            std::array<const SampleType*, NumBands> src;
+            for (size_t band = 0; band < NumBands; ++band)
+                src[band] = bands[band].getReadPointer(ch);
+
+            auto* dest = output.getWritePointer(ch);
+
+            //fixed trip count over the bands so the compiler unrolls it and vectorises across samples
+            if (isRamping)
+            {
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    auto sum = SampleType(0);
+                    for (size_t band = 0; band < NumBands; ++band)
+                        sum += bandGains[band] * src[band][i];
+
+                    dest[i] = sum * gainRamp[static_cast<size_t>(i)];
+                }
+            }
+            else
+            {
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    auto sum = SampleType(0);
+                    for (size_t band = 0; band < NumBands; ++band)
+                        sum += bandGains[band] * src[band][i];
+
+                    dest[i] = sum;
+                }
+            }
+        }
+    }
+private:
+    juce::LinearSmoothedValue<SampleType> gain{ SampleType(1) };
+    std::vector<SampleType> gainRamp;
+
+    double sampleRate = 0.0;
+    double rampDurationSeconds = 0.0;
+};
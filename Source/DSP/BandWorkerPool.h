@@ -0,0 +1,220 @@
+/*
+  ==============================================================================
+
+    BandWorkerPool.h
+    Created: 17 Oct 2026 7:48:16pm
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "Semaphore.h"
+
+#if JUCE_INTEL
+ #include <immintrin.h>
+#endif
+
+/*
+ A few pre-spawned threads that help the audio thread through a batch of independent jobs.
+
+ run() publishes the batch in one atomic word and then takes jobs itself, so a batch always
+ completes even if no worker wakes up in time. Workers claim jobs from the same word, and the
+ audio thread only spins at the end for jobs a worker is already in the middle of.
+ Nothing on the audio thread allocates or locks.
+
+ After a batch a worker keeps looking for the next one for SpinMicroseconds, then parks on a
+ Semaphore. run() posts it once per parked worker, and skips the post when none are parked.
+ A worker counts itself as parked before it takes its last look at the batch word, so a batch
+ published in between is either seen or posted for. The worst left over is a spare post, which
+ costs one worker a spurious wake.
+
+ start() and stop() may run while the audio thread is inside run(): run() only reads the atomic
+ worker count, never the threads themselves.
+ */
+struct BandWorkerPool
+{
+    static constexpr double SpinMicroseconds = 5.0;
+    static constexpr int MaxJobs = 255;
+
+    ~BandWorkerPool()
+    {
+        stop();
+    }
+
+    /** message thread only, spawns the workers (stopping any previous ones first) */
+    void start(int numWorkers)
+    {
+        stop();
+
+        for (int i = 0; i < numWorkers; ++i)
+        {
+            workers.push_back(std::make_unique<Worker>(*this, i));
+            workers.back()->startThread(juce::Thread::Priority::highest);
+        }
+
+        numRunning.store(numWorkers, std::memory_order_release);
+    }
+
+    /** message thread only */
+    void stop()
+    {
+        numRunning.store(0, std::memory_order_release);
+
+        for (auto& worker : workers)
+            worker->signalThreadShouldExit();
+
+        //parked workers have to wake up to see that
+        wake.post(static_cast<int>(workers.size()));
+
+        for (auto& worker : workers)
+            worker->stopThread(1000);
+
+        workers.clear();
+    }
+
+    int getNumWorkers() const { return static_cast<int>(workers.size()); }
+
+    /** true while the calling thread is inside a batch, for tools that police the audio path */
+    static bool isRunningJobs() { return runningJobs; }
+
+    /**
+     calls job(index) for every index in [0, numJobs) and returns once they have all finished.
+     The calling thread takes part, job must stay alive until this returns.
+     */
+    template <typename Job>
+    void run(int numJobs, Job& job)
+    {
+        jassert(numJobs <= MaxJobs);
+
+        if (numRunning.load(std::memory_order_acquire) == 0 || numJobs < 2)
+        {
+            for (int i = 0; i < numJobs; ++i)
+                job(i);
+
+            return;
+        }
+
+        //plain writes, the release store of the batch word publishes them to whoever claims a job
+        context = &job;
+        invoke = [](void* c, int index) { (*static_cast<Job*>(c))(index); };
+        jobsDone.store(0, std::memory_order_relaxed);
+
+        generation = (generation + 1) & 0xffff;
+        batch.store(packBatch(generation, numJobs, 0), std::memory_order_seq_cst);
+
+        //seq_cst against the workers' count-then-look, see the note at the top
+        wake.post(numParked.exchange(0, std::memory_order_seq_cst));
+
+        runJobs(generation);
+
+        while (jobsDone.load(std::memory_order_acquire) < numJobs)
+            spinPause();
+    }
+private:
+    struct Worker : juce::Thread
+    {
+        Worker(BandWorkerPool& p, int index) : juce::Thread("Band worker " + juce::String(index + 1)), pool(p) { }
+
+        void run() override
+        {
+            juce::ScopedNoDenormals noDenormals;
+
+            const auto spinTicks = static_cast<juce::int64>(SpinMicroseconds * 1.0e-6 * static_cast<double>(juce::Time::getHighResolutionTicksPerSecond()));
+
+            auto seenGeneration = getGeneration(pool.batch.load(std::memory_order_acquire));
+            auto lastBatchTicks = juce::Time::getHighResolutionTicks();
+
+            while (! threadShouldExit())
+            {
+                auto currentGeneration = getGeneration(pool.batch.load(std::memory_order_acquire));
+
+                if (currentGeneration != seenGeneration)
+                {
+                    seenGeneration = currentGeneration;
+                    pool.runJobs(currentGeneration);
+                    lastBatchTicks = juce::Time::getHighResolutionTicks();
+                    continue;
+                }
+
+                if (juce::Time::getHighResolutionTicks() - lastBatchTicks < spinTicks)
+                {
+                    spinPause();
+                    continue;
+                }
+
+                pool.numParked.fetch_add(1, std::memory_order_seq_cst);
+
+                if (getGeneration(pool.batch.load(std::memory_order_seq_cst)) == seenGeneration && ! threadShouldExit())
+                    pool.wake.wait();
+
+                lastBatchTicks = juce::Time::getHighResolutionTicks();
+            }
+        }
+
+        BandWorkerPool& pool;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    //generation << 16 | number of jobs << 8 | next unclaimed job
+    std::atomic<juce::uint32> batch{ 0 };
+    std::atomic<int> jobsDone{ 0 };
+    std::atomic<int> numRunning{ 0 }, numParked{ 0 };
+    Semaphore wake;
+
+    //a plain bool, so it can be read from inside allocation and lock hooks
+    static inline thread_local bool runningJobs = false;
+
+    struct JobsScope
+    {
+        JobsScope() { runningJobs = true; }
+        ~JobsScope() { runningJobs = false; }
+    };
+
+    //only touched by the thread calling run()
+    juce::uint32 generation = 0;
+    void (*invoke)(void*, int) = nullptr;
+    void* context = nullptr;
+
+    static juce::uint32 packBatch(juce::uint32 batchGeneration, int numJobs, int next)
+    {
+        return (batchGeneration << 16) | (static_cast<juce::uint32>(numJobs) << 8) | static_cast<juce::uint32>(next);
+    }
+
+    static juce::uint32 getGeneration(juce::uint32 word) { return word >> 16; }
+
+    void runJobs(juce::uint32 batchGeneration)
+    {
+        const JobsScope scope;
+        auto word = batch.load(std::memory_order_acquire);
+
+        for (;;)
+        {
+            const auto numJobs = static_cast<int>((word >> 8) & 0xff);
+            const auto index = static_cast<int>(word & 0xff);
+
+            //a worker still draining the previous batch must not claim from the next one
+            if (getGeneration(word) != batchGeneration || index >= numJobs)
+                return;
+
+            if (! batch.compare_exchange_weak(word, word + 1, std::memory_order_acq_rel, std::memory_order_acquire))
+                continue;
+
+            invoke(context, index);
+            jobsDone.fetch_add(1, std::memory_order_release);
+
+            word = batch.load(std::memory_order_acquire);
+        }
+    }
+
+    static void spinPause()
+    {
+       #if JUCE_INTEL
+        _mm_pause();
+       #elif JUCE_ARM && (JUCE_GCC || JUCE_CLANG)
+        __asm__ __volatile__ ("yield");
+       #endif
+    }
+};
@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+    BlockDelayLine.h
+    Created: 17 Oct 2026 3:05:27pm
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+ Whole-sample delay on a preallocated ring buffer.
+ Each block is copied into the ring and the delayed block copied back out, at most two
+ contiguous copies each way, so there is no per-sample wrap-around arithmetic.
+ */
+template <typename SampleType>
+struct BlockDelayLine
+{
+    void prepare(int numChannels, int maximumDelaySamples, int maximumBlockSize)
+    {
+        maxDelay = juce::jmax(0, maximumDelaySamples);
+        delay = juce::jmin(delay, maxDelay);
+
+        buffer.setSize(numChannels, maxDelay + juce::jmax(1, maximumBlockSize), false, true, false);
+        reset();
+    }
+
+    void reset()
+    {
+        buffer.clear();
+        writePosition = 0;
+    }
+
+    void setDelay(int newDelaySamples)
+    {
+        jassert(newDelaySamples >= 0 && newDelaySamples <= maxDelay);
+        delay = juce::jlimit(0, maxDelay, newDelaySamples);
+    }
+
+    int getDelay() const { return delay; }
+
+    /** delays the block in place */
+    void process(const juce::dsp::AudioBlock<SampleType>& block)
+    {
+        if (delay == 0)
+            return;
+
+        const auto size = buffer.getNumSamples();
+        const auto numChannels = juce::jmin(static_cast<int>(block.getNumChannels()), buffer.getNumChannels());
+        const auto numSamples = static_cast<int>(block.getNumSamples());
+
+        //the ring only has room for maxDelay + one prepared block, bigger blocks go through in pieces
+        const auto maxChunk = size - delay;
+
+        for (auto start = 0; start < numSamples; start += maxChunk)
+        {
+            auto chunk = juce::jmin(maxChunk, numSamples - start);
+
+            auto readPosition = writePosition - delay;
+            if (readPosition < 0)
+                readPosition += size;
+
+            for (auto ch = 0; ch < numChannels; ++ch)
+            {
+                auto* samples = block.getChannelPointer(static_cast<size_t>(ch)) + start;
+                auto* ring = buffer.getWritePointer(ch);
+
+                writeToRing(ring, size, writePosition, samples, chunk);
+                readFromRing(ring, size, readPosition, samples, chunk);
+            }
+
+            writePosition += chunk;
+            if (writePosition >= size)
+                writePosition -= size;
+        }
+    }
+private:
+    juce::AudioBuffer<SampleType> buffer;
+    int writePosition = 0;
+    int delay = 0;
+    int maxDelay = 0;
+
+    static void writeToRing(SampleType* ring, int size, int position, const SampleType* source, int numSamples)
+    {
+        auto firstPart = juce::jmin(numSamples, size - position);
+        juce::FloatVectorOperations::copy(ring + position, source, firstPart);
+        juce::FloatVectorOperations::copy(ring, source + firstPart, numSamples - firstPart);
+    }
+
+    static void readFromRing(const SampleType* ring, int size, int position, SampleType* dest, int numSamples)
+    {
+        auto firstPart = juce::jmin(numSamples, size - position);
+        juce::FloatVectorOperations::copy(dest, ring + position, firstPart);
+        juce::FloatVectorOperations::copy(dest + firstPart, ring, numSamples - firstPart);
+    }
+};
@@ -10,36 +10,321 @@
 
 #include "CompressorBand.h"
 
-void CompressorBand::prepare(const juce::dsp::ProcessSpec& spec)
+template <typename SampleType>
+void CompressorBand<SampleType>::prepare(const juce::dsp::ProcessSpec& spec)
 {
-    compressor.prepare(spec);
+    baseSpec = spec;
+
+    auto maxOversamplingLatency = 0;
+    for (size_t i = 0; i < oversamplers.size(); ++i)
+    {
+        auto& oversampler = oversamplers[i];
+        oversampler = std::make_unique<juce::dsp::Oversampling<SampleType>>(spec.numChannels,
+                                                                             i + 1,
+                                                                             juce::dsp::Oversampling<SampleType>::filterHalfBandFIREquiripple,
+                                                                             true,
+                                                                             true); //whole-sample latency, so the other bands can be delayed to match
+        oversampler->initProcessing(spec.maximumBlockSize);
+        maxOversamplingLatency = juce::jmax(maxOversamplingLatency, juce::roundToInt(oversampler->getLatencyInSamples()));
+    }
+
+    //everything below is sized for the worst case (8x, full lookahead) so nothing reallocates later
+    const auto maxFactor = 1 << MaxOversamplingOrder;
+    const auto numChannels = static_cast<int>(spec.numChannels);
+    const auto maxBlockSize = static_cast<int>(spec.maximumBlockSize);
+    const auto maxLookahead = static_cast<int>(std::ceil(MaxLookaheadMs * 0.001 * spec.sampleRate));
+
+    lookaheadDelay.prepare(numChannels, maxLookahead * maxFactor, maxBlockSize * maxFactor);
+    gainBuffer.setSize(numChannels, maxBlockSize * maxFactor, false, true, false);
+    keyBuffer.setSize(1, maxBlockSize * maxFactor, false, true, false);
+
+    alignmentDelay.prepare(numChannels, maxOversamplingLatency + maxLookahead, maxBlockSize);
+
+    inputMeter.prepare(spec.sampleRate, numChannels, maxBlockSize);
+    outputMeter.prepare(spec.sampleRate, numChannels, maxBlockSize);
+
+    //both depend on the sample rate, so they get re-applied from the parameters
+    oversamplingSnapshot.invalidate();
+    lookaheadSnapshot.invalidate();
+
+    setOversamplingOrder(0);
+    if (Oversampling != nullptr)
+        updateCompressorSettings();
 }
 
-void CompressorBand::updateCompressorSettings()
+template <typename SampleType>
+bool CompressorBand<SampleType>::updateCompressorSettings()
 {
-    compressor.setAttack(Attack->get());
-    compressor.setRelease(Release->get());
-    compressor.setThreshold(Threshold->get());
-    compressor.setRatio(Ratio->getCurrentChoiceName().getFloatValue());
+    //each parameter is read once per block, coefficients only get recomputed when their control moved
+    if (attackSnapshot.update(Attack->get()))
+        kernel.setAttackTime(attackSnapshot.get());
+
+    if (releaseSnapshot.update(Release->get()))
+        kernel.setReleaseTime(releaseSnapshot.get());
+
+    if (thresholdSnapshot.update(Threshold->get()))
+        kernel.setThreshold(thresholdSnapshot.get());
+
+    if (ratioSnapshot.update(Ratio->getIndex()))
+        kernel.setRatio(Params::RatioChoices[static_cast<size_t>(ratioSnapshot.get())]);
+
+    if (DetectorLink != nullptr && linkSnapshot.update(DetectorLink->getIndex()))
+        kernel.setLinkGroupSize(Params::LinkGroupSizes[static_cast<size_t>(linkSnapshot.get())]);
+
+    if (oversamplers[0] == nullptr) //not prepared yet
+        return false;
+
+    auto previousLatency = latencySamples;
+
+    if (oversamplingSnapshot.update(Oversampling->getIndex()))
+        setOversamplingOrder(static_cast<size_t>(oversamplingSnapshot.get()));
+
+    if (lookaheadSnapshot.update(Lookahead->get()))
+        setLookahead(juce::roundToInt(lookaheadSnapshot.get() * 0.001 * baseSpec.sampleRate));
+
+    return latencySamples != previousLatency;
 }
 
-void CompressorBand::process(juce::AudioBuffer<float>& buffer)
+template <typename SampleType>
+void CompressorBand<SampleType>::setOversamplingOrder(size_t newOrder)
 {
-    auto preRMS = computeRMSLevel(buffer);
-    auto block = juce::dsp::AudioBlock<float>(buffer);
-    auto context = juce::dsp::ProcessContextReplacing<float>(block);
+    jassert(newOrder <= MaxOversamplingOrder);
+    oversamplingOrder = newOrder;
 
-    context.isBypassed = Bypassed->get();
+    //the detector runs at the oversampled rate, so its ballistics need re-deriving
+    kernel.prepare(baseSpec.sampleRate * static_cast<double>(1 << newOrder), static_cast<int>(baseSpec.numChannels));
 
-    compressor.process(context);
+    lookaheadDelay.reset();
+
+    if (newOrder > 0)
+    {
+        auto& oversampler = *oversamplers[newOrder - 1];
+        oversampler.reset();
+        oversamplingLatencySamples = juce::roundToInt(oversampler.getLatencyInSamples());
+    }
+    else
+    {
+        oversamplingLatencySamples = 0;
+    }
+
+    setLookahead(lookaheadSamples);
+}
+
+template <typename SampleType>
+void CompressorBand<SampleType>::setLookahead(int newLookaheadSamples)
+{
+    lookaheadSamples = newLookaheadSamples;
+
+    //the lookahead line sits inside the oversampled section
+    lookaheadDelay.setDelay(lookaheadSamples << oversamplingOrder);
+
+    latencySamples = oversamplingLatencySamples + lookaheadSamples;
+}
+
+template <typename SampleType>
+void CompressorBand<SampleType>::reset()
+{
+    kernel.reset();
+    lookaheadDelay.reset();
+    alignmentDelay.reset();
+
+    if (oversamplingOrder > 0)
+        oversamplers[oversamplingOrder - 1]->reset();
+
+    inputMeter.reset();
+    outputMeter.reset();
+    gainReductionStream.reset();
+}
+
+template <typename SampleType>
+void CompressorBand<SampleType>::addIdleGains(int numSamples)
+{
+    //counted at the detector's rate, like the values compress() adds
+    gainReductionStream.addGains<SampleType>(nullptr, 0, numSamples << oversamplingOrder, GainReductionStream::DecimationSamples << oversamplingOrder);
+}
+
+template <typename SampleType>
+void CompressorBand<SampleType>::setMetering(float rmsWindowMs, float peakReleaseDbPerSecond, bool measureTruePeak)
+{
+    inputMeter.setBallistics(rmsWindowMs, peakReleaseDbPerSecond);
+    outputMeter.setBallistics(rmsWindowMs, peakReleaseDbPerSecond);
+    outputMeter.setTruePeakEnabled(measureTruePeak);
+}
+
+template <typename SampleType>
+void CompressorBand<SampleType>::setAlignmentLatency(int totalLatencySamples)
+{
+    jassert(totalLatencySamples >= latencySamples);
+    alignmentDelay.setDelay(totalLatencySamples - latencySamples);
+}
+
+template <typename SampleType>
+void CompressorBand<SampleType>::compress(const juce::dsp::AudioBlock<SampleType>& block, bool isBypassed, bool useKey, bool updateMeters)
+{
+    const auto numChannels = block.getNumChannels();
+    const auto numSamples = block.getNumSamples();
 
-    auto postRMS = computeRMSLevel(buffer);
+    //at the base rate the meters ride along with the loops below instead of making passes of their own
+    BlockLevels<SampleType> inputLevels, outputLevels;
+    auto* inputTap = updateMeters ? &inputLevels : nullptr;
 
-    auto convertToDb = [](auto input)
+    //the envelope lanes mean different things with and without the key
+    if (useKey != isUsingKey)
     {
-        return juce::Decibels::gainToDecibels(input);
-    };
+        isUsingKey = useKey;
+        kernel.reset();
+    }
+
+    //the detector sees the signal now, the audio it acts on comes out of the lookahead line later
+    if (! isBypassed)
+    {
+        if (useKey)
+        {
+            //one detector on the key, every channel gets its gain
+            kernel.computeGains(juce::dsp::AudioBlock<SampleType>(keyBuffer).getSubBlock(0, numSamples), gainBuffer);
+
+            for (size_t ch = 1; ch < numChannels; ++ch)
+            {
+                juce::FloatVectorOperations::copy(gainBuffer.getWritePointer(static_cast<int>(ch)),
+                                                  gainBuffer.getReadPointer(0),
+                                                  static_cast<int>(numSamples));
+            }
+        }
+        else
+        {
+            kernel.computeGains(block, gainBuffer, inputTap);
+        }
+    }
+    else if (inputTap != nullptr)
+    {
+        //a bypassed band's output is its input a lookahead later, one pass does for both meters
+        for (size_t ch = 0; ch < numChannels; ++ch)
+            inputLevels.add(block.getChannelPointer(ch), static_cast<int>(numSamples));
+    }
+
+    //DecimationSamples at the base rate, whatever the oversampling
+    const auto samplesPerValue = GainReductionStream::DecimationSamples << oversamplingOrder;
+    gainReductionStream.addGains(isBypassed ? nullptr : &gainBuffer, static_cast<int>(numChannels), static_cast<int>(numSamples), samplesPerValue);
+
+    //still delayed when bypassed, otherwise the band would jump out of line with the others
+    lookaheadDelay.process(block);
+
+    //the key's detector never saw the input, so it's read on its way through the gains instead
+    if (! isBypassed)
+        applyGains(block, useKey ? inputTap : nullptr, updateMeters ? &outputLevels : nullptr);
+
+    if (updateMeters)
+    {
+        inputMeter.update(inputLevels, static_cast<int>(numSamples), static_cast<int>(numChannels));
+
+        //true peak needs the samples themselves, process() measures the output after all then
+        if (! outputMeter.isTruePeakEnabled())
+            outputMeter.update(isBypassed ? inputLevels : outputLevels, static_cast<int>(numSamples), static_cast<int>(numChannels));
+    }
+}
+
+template <typename SampleType>
+void CompressorBand<SampleType>::applyGains(const juce::dsp::AudioBlock<SampleType>& block,
+                                            BlockLevels<SampleType>* inputLevels,
+                                            BlockLevels<SampleType>* outputLevels)
+{
+    using Levels = BlockLevels<SampleType>;
+
+    const auto numSamples = static_cast<int>(block.getNumSamples());
+    const auto vectorEnd = numSamples - numSamples % Levels::Lanes;
+
+    for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
+    {
+        auto* samples = block.getChannelPointer(ch);
+        const auto* gains = gainBuffer.getReadPointer(static_cast<int>(ch));
+
+        if (inputLevels == nullptr && outputLevels == nullptr)
+        {
+            juce::FloatVectorOperations::multiply(samples, gains, numSamples);
+            continue;
+        }
+
+        for (int i = 0; i < vectorEnd; i += Levels::Lanes)
+        {
+            auto x = Levels::load(samples + i);
+            auto y = x * Levels::load(gains + i);
+            Levels::store(samples + i, y);
+
+            if (inputLevels != nullptr)
+                inputLevels->add(x);
+            if (outputLevels != nullptr)
+                outputLevels->add(y);
+        }
+
+        for (int i = vectorEnd; i < numSamples; ++i)
+        {
+            auto x = samples[i];
+            samples[i] = x * gains[i];
+
+            if (inputLevels != nullptr)
+                inputLevels->add(x);
+            if (outputLevels != nullptr)
+                outputLevels->add(samples[i]);
+        }
+    }
+}
+
+template <typename SampleType>
+void CompressorBand<SampleType>::process(juce::AudioBuffer<SampleType>& buffer, const SampleType* key)
+{
+    auto block = juce::dsp::AudioBlock<SampleType>(buffer);
+
+    auto isBypassed = Bypassed->get();
+    auto useKey = key != nullptr;
+
+    if (useKey)
+        holdKey(key, buffer.getNumSamples());
+
+    if (oversamplingOrder > 0)
+    {
+        //the oversampled loops see the wrong rate for the meters, so they get passes of their own
+        inputMeter.measure(juce::dsp::AudioBlock<const SampleType>(buffer));
+
+        auto& oversampler = *oversamplers[oversamplingOrder - 1];
+        auto oversampledBlock = oversampler.processSamplesUp(block);
+
+        compress(oversampledBlock, isBypassed, useKey, false);
+
+        oversampler.processSamplesDown(block);
+        alignmentDelay.process(block);
+
+        outputMeter.measure(juce::dsp::AudioBlock<const SampleType>(buffer));
+    }
+    else
+    {
+        //the output is read before the alignment delay, a shift the meters' ballistics can't show
+        compress(block, isBypassed, useKey, true);
+        alignmentDelay.process(block);
+
+        if (outputMeter.isTruePeakEnabled())
+            outputMeter.measure(juce::dsp::AudioBlock<const SampleType>(buffer));
+    }
+}
+
+template <typename SampleType>
+void CompressorBand<SampleType>::holdKey(const SampleType* key, int numSamples)
+{
+    //detector-grade is enough for the key, so it is held rather than run through the oversampling filters
+    const auto factor = 1 << oversamplingOrder;
+    auto* dest = keyBuffer.getWritePointer(0);
+
+    if (factor == 1)
+    {
+        juce::FloatVectorOperations::copy(dest, key, numSamples);
+        return;
+    }
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        for (int k = 0; k < factor; ++k)
+            dest[(i << oversamplingOrder) + k] = key[i];
+    }
+}
 
-    rmsInputDb.store(convertToDb(preRMS));
-    rmsOutputDb.store(convertToDb(postRMS));
-}
\ No newline at end of file
+template struct CompressorBand<float>;
+template struct CompressorBand<double>;
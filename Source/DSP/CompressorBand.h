@@ -11,7 +11,14 @@
 #pragma once
 #include <JuceHeader.h>
 #include "../GUI/Utilities.h"
+#include "BlockDelayLine.h"
+#include "CompressorKernel.h"
+#include "BandMeter.h"
+#include "GainReductionStream.h"
+#include "ParamSnapshot.h"
+#include "Params.h"
 
+template <typename SampleType>
 struct CompressorBand
 {
     juce::AudioParameterFloat* Attack{ nullptr };
@@ -21,32 +28,75 @@ struct CompressorBand
     juce::AudioParameterBool* Bypassed{ nullptr };
     juce::AudioParameterBool* Mute{ nullptr };
     juce::AudioParameterBool* Solo{ nullptr };
+    juce::AudioParameterChoice* Oversampling{ nullptr };
+    juce::AudioParameterFloat* Lookahead{ nullptr };
+    juce::AudioParameterChoice* DetectorLink{ nullptr };
 
     void prepare(const juce::dsp::ProcessSpec& spec);
 
-    void updateCompressorSettings();
+    /** returns true when the band's latency changed and the bands need re-aligning */
+    bool updateCompressorSettings();
 
-    void process(juce::AudioBuffer<float>& buffer);
+    /** key, when given, is this band's slice of the sidechain (one channel) and drives the detector instead of the band itself */
+    void process(juce::AudioBuffer<SampleType>& buffer, const SampleType* key = nullptr);
 
-    float getRMSInputDb() const { return rmsInputDb; }
-    float getRMSOutputDb() const { return rmsOutputDb; }
+    /** clears the detector, the delay lines and the oversampling filters, meters drop to -inf */
+    void reset();
+
+    /** numSamples of unity gain for the gain reduction stream, for blocks the core skips while idle */
+    void addIdleGains(int numSamples);
+
+    float getRMSInputDb() const { return inputMeter.getRMSDb(); }
+    float getRMSOutputDb() const { return outputMeter.getRMSDb(); }
+    float getPeakInputDb() const { return inputMeter.getPeakDb(); }
+    float getPeakOutputDb() const { return outputMeter.getPeakDb(); }
+    float getTruePeakOutputDb() const { return outputMeter.getTruePeakDb(); }
+
+    /** decimated gain reduction for the editor, see GainReductionStream */
+    GainReductionStream& getGainReductionStream() { return gainReductionStream; }
+
+    /** RMS averaging window and peak fall-back for both meters, true peak is only measured on the output */
+    void setMetering(float rmsWindowMs, float peakReleaseDbPerSecond, bool measureTruePeak);
+
+    static constexpr float MaxLookaheadMs = 10.f;
+
+    /** latency of this band's own processing (oversampling filters + lookahead) */
+    int getLatencySamples() const { return latencySamples; }
+
+    /** pads this band with a delay so it comes out totalLatencySamples late, like the other bands */
+    void setAlignmentLatency(int totalLatencySamples);
 private:
-    juce::dsp::Compressor<float> compressor;
-
-    std::atomic<float> rmsInputDb{ NEGATIVE_INFINITY };
-    std::atomic<float> rmsOutputDb{ NEGATIVE_INFINITY };
-
-    template<typename T>
-    float computeRMSLevel(const T& buffer)
-    {
-        int numChannels = static_cast<int>(buffer.getNumChannels());
-        int numSamples = static_cast<int>(buffer.getNumSamples());
-        auto rms = 0.f;
-        for (int chan = 0; chan < numChannels; chan++)
-        {
-            rms += buffer.getRMSLevel(chan, 0, numSamples);
-        }
-        rms /= static_cast<float>(numChannels);
-        return rms;
-    }
+    //computes gains ahead of the audio, which then goes through the lookahead line
+    CompressorKernel<SampleType> kernel;
+
+    ParamSnapshot<float> attackSnapshot, releaseSnapshot, thresholdSnapshot, lookaheadSnapshot;
+    ParamSnapshot<int> ratioSnapshot, oversamplingSnapshot, linkSnapshot;
+
+    BlockDelayLine<SampleType> lookaheadDelay;
+    juce::AudioBuffer<SampleType> gainBuffer;
+
+    //sidechain key at the detector's rate
+    juce::AudioBuffer<SampleType> keyBuffer;
+    bool isUsingKey = false;
+    int lookaheadSamples = 0; //at the base rate
+
+    static constexpr size_t MaxOversamplingOrder = 3; //8x
+
+    //one per factor, all built in prepare so switching never allocates
+    std::array<std::unique_ptr<juce::dsp::Oversampling<SampleType>>, MaxOversamplingOrder> oversamplers;
+    size_t oversamplingOrder = 0;
+    juce::dsp::ProcessSpec baseSpec{};
+
+    BlockDelayLine<SampleType> alignmentDelay;
+    int oversamplingLatencySamples = 0;
+    int latencySamples = 0;
+
+    void setOversamplingOrder(size_t newOrder);
+    void setLookahead(int newLookaheadSamples);
+    void compress(const juce::dsp::AudioBlock<SampleType>& block, bool isBypassed, bool useKey, bool updateMeters);
+    void applyGains(const juce::dsp::AudioBlock<SampleType>& block, BlockLevels<SampleType>* inputLevels, BlockLevels<SampleType>* outputLevels);
+    void holdKey(const SampleType* key, int numSamples);
+
+    BandMeter<SampleType> inputMeter, outputMeter;
+    GainReductionStream gainReductionStream;
 };
\ No newline at end of file
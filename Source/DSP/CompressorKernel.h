@@ -0,0 +1,305 @@
+/*
+  ==============================================================================
+
+    CompressorKernel.h
+    Created: 17 Oct 2026 4:22:51pm
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "BandMeter.h"
+
+/*
+ Feed-forward compressor gain computer, same response as juce::dsp::Compressor
+ (peak BallisticsFilter into a hard-knee gain law) without the per-sample log10/pow.
+
+ It runs in two passes over a block:
+
+     1. envelope   env = x + cte * (env - x), cte picked branch-free from attack/release.
+                   The recursion is serial in time, so the vectorising goes across channels:
+                   every detector gets a SIMD lane, the way the crossover packs its lanes.
+     2. gain       log2(gain) = min(0, (log2(env) - log2(threshold)) * (1/ratio - 1))
+                   with polynomial log2/exp2, no branches or libm calls, so the compiler
+                   can vectorise it across samples.
+
+ Channels can be linked in groups of consecutive channels (pairs, or the whole bus).
+ A group runs one detector on the loudest of its channels and applies the same gain to all
+ of them, so the image doesn't shift when one side compresses harder than the other.
+
+ Given BlockLevels, the first pass that reads the input (the envelope, or the group peak when
+ channels are linked) takes its sum of squares and peak as well, so the band's input meter
+ needs no pass of its own.
+
+ The envelope runs at SampleType precision; the gain law is evaluated in float either way,
+ its approximations are far coarser than float resolution.
+ */
+template <typename SampleType>
+struct CompressorKernel
+{
+    static constexpr int MaxChannels = 16;
+
+    void prepare(double newSampleRate, int newNumChannels)
+    {
+        jassert(newNumChannels <= MaxChannels);
+
+        sampleRate = newSampleRate;
+        numChannels = juce::jmin(newNumChannels, MaxChannels);
+
+        //same formula BallisticsFilter uses
+        expFactor = -2.0 * juce::MathConstants<double>::pi * 1000.0 / sampleRate;
+        setAttackTime(attackTime);
+        setReleaseTime(releaseTime);
+
+        reset();
+    }
+
+    void reset()
+    {
+        envelopes.fill(Register::expand(SampleType(0)));
+    }
+
+    void setAttackTime(float attackMs)
+    {
+        attackTime = attackMs;
+        cteAttack = calculateLimitedCte(attackMs);
+    }
+
+    void setReleaseTime(float releaseMs)
+    {
+        releaseTime = releaseMs;
+        cteRelease = calculateLimitedCte(releaseMs);
+    }
+
+    void setThreshold(float thresholdDb)
+    {
+        //-200dB floor, same as juce::dsp::Compressor
+        log2Threshold = juce::jmax(thresholdDb, -200.f) * Log2PerDb;
+    }
+
+    void setRatio(float ratio)
+    {
+        jassert(ratio >= 1.f);
+        slope = 1.f / ratio - 1.f;
+    }
+
+    /** 1 runs every channel on its own, MaxChannels links the whole bus */
+    void setLinkGroupSize(int newGroupSize)
+    {
+        newGroupSize = juce::jlimit(1, MaxChannels, newGroupSize);
+
+        if (newGroupSize != linkGroupSize)
+        {
+            linkGroupSize = newGroupSize;
+            reset();
+        }
+    }
+
+    /** writes one gain per input sample into gains, the input is left untouched */
+    void computeGains(const juce::dsp::AudioBlock<SampleType>& input, juce::AudioBuffer<SampleType>& gains,
+                      BlockLevels<SampleType>* inputLevels = nullptr)
+    {
+        const auto numSamples = static_cast<int>(input.getNumSamples());
+        const auto channels = juce::jmin(static_cast<int>(input.getNumChannels()), numChannels);
+        jassert(numSamples <= gains.getNumSamples() && channels <= gains.getNumChannels());
+
+        const auto groupSize = juce::jmin(linkGroupSize, juce::jmax(channels, 1));
+        const auto numGroups = (channels + groupSize - 1) / groupSize;
+
+        //each group's detector signal and envelope live in the gain row of its first channel
+        std::array<const SampleType*, MaxChannels> detectors{};
+        std::array<SampleType*, MaxChannels> leaders{};
+
+        for (int group = 0; group < numGroups; ++group)
+        {
+            const auto first = group * groupSize;
+            const auto last = juce::jmin(first + groupSize, channels);
+            auto* leader = gains.getWritePointer(first);
+
+            if (last - first > 1)
+            {
+                computeGroupPeak(input, leader, first, last, numSamples, inputLevels);
+                detectors[static_cast<size_t>(group)] = leader;
+            }
+            else
+            {
+                detectors[static_cast<size_t>(group)] = input.getChannelPointer(static_cast<size_t>(first));
+
+                //the odd channel left over after the linked groups
+                if (groupSize > 1 && inputLevels != nullptr)
+                    inputLevels->add(detectors[static_cast<size_t>(group)], numSamples);
+            }
+
+            leaders[static_cast<size_t>(group)] = leader;
+        }
+
+        //a lane is a channel only while nothing is linked, otherwise the group peaks took the levels
+        computeEnvelopes(detectors, leaders, numGroups, numSamples, groupSize == 1 ? inputLevels : nullptr);
+
+        for (int group = 0; group < numGroups; ++group)
+        {
+            const auto first = group * groupSize;
+            const auto last = juce::jmin(first + groupSize, channels);
+            auto* leader = leaders[static_cast<size_t>(group)];
+
+            envelopeToGain(leader, numSamples);
+
+            for (int ch = first + 1; ch < last; ++ch)
+                juce::FloatVectorOperations::copy(gains.getWritePointer(ch), leader, numSamples);
+        }
+    }
+private:
+    static constexpr float Log2PerDb = 0.166096404744f; //1 / (20 * log10(2))
+
+    using Register = juce::dsp::SIMDRegister<SampleType>;
+    static constexpr size_t MaxRegisters = (MaxChannels + Register::size() - 1) / Register::size();
+
+    double sampleRate = 44100.0, expFactor = 0.0;
+    int numChannels = 0;
+
+    float attackTime = 1.f, releaseTime = 100.f;
+    SampleType cteAttack = 0, cteRelease = 0;
+    float log2Threshold = 0.f, slope = 0.f;
+    int linkGroupSize = 1;
+
+    //one lane per detector
+    std::array<Register, MaxRegisters> envelopes;
+    std::array<Register, MaxRegisters> lanes;
+
+    SampleType calculateLimitedCte(float timeMs) const
+    {
+        return timeMs < 1.0e-3f ? SampleType(0) : static_cast<SampleType>(std::exp(expFactor / timeMs));
+    }
+
+    void computeEnvelopes(const std::array<const SampleType*, MaxChannels>& in,
+                          const std::array<SampleType*, MaxChannels>& out,
+                          int numLanes,
+                          int numSamples,
+                          BlockLevels<SampleType>* levels)
+    {
+        const auto lanesUsed = static_cast<size_t>(numLanes);
+        const auto numRegisters = (lanesUsed + Register::size() - 1) / Register::size();
+
+        const auto attackMinusRelease = Register::expand(cteAttack - cteRelease);
+        const auto release = Register::expand(cteRelease);
+
+        auto* laneSamples = reinterpret_cast<SampleType*>(lanes.data());
+        auto* laneEnvelopes = reinterpret_cast<const SampleType*>(envelopes.data());
+
+        //unused lanes in the last register stay silent
+        std::fill(laneSamples, laneSamples + numRegisters * Register::size(), SampleType(0));
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            for (size_t lane = 0; lane < lanesUsed; ++lane)
+                laneSamples[lane] = in[lane][i];
+
+            for (size_t r = 0; r < numRegisters; ++r)
+            {
+                //unused lanes are zero, they add nothing
+                if (levels != nullptr)
+                    levels->add(lanes[r]);
+
+                auto level = Register::abs(lanes[r]);
+                auto& env = envelopes[r];
+
+                //attack where the level is above the envelope, release everywhere else
+                auto isRising = Register::greaterThan(level, env);
+                auto cte = release + (attackMinusRelease & isRising);
+
+                env = level + cte * (env - level);
+            }
+
+            for (size_t lane = 0; lane < lanesUsed; ++lane)
+                out[lane][i] = laneEnvelopes[lane];
+        }
+    }
+
+    void computeGroupPeak(const juce::dsp::AudioBlock<SampleType>& input, SampleType* output, int first, int last, int numSamples,
+                          BlockLevels<SampleType>* levels)
+    {
+        using Levels = BlockLevels<SampleType>;
+        const auto vectorEnd = numSamples - numSamples % Levels::Lanes;
+
+        std::fill(output, output + numSamples, SampleType(0));
+
+        for (int ch = first; ch < last; ++ch)
+        {
+            auto* samples = input.getChannelPointer(static_cast<size_t>(ch));
+
+            for (int i = 0; i < vectorEnd; i += Levels::Lanes)
+            {
+                auto x = Levels::load(samples + i);
+                Levels::store(output + i, Register::max(Levels::load(output + i), Register::abs(x)));
+
+                if (levels != nullptr)
+                    levels->add(x);
+            }
+
+            for (int i = vectorEnd; i < numSamples; ++i)
+            {
+                output[i] = juce::jmax(output[i], std::abs(samples[i]));
+
+                if (levels != nullptr)
+                    levels->add(samples[i]);
+            }
+        }
+    }
+
+    void envelopeToGain(SampleType* samples, int numSamples) const
+    {
+        const auto threshold = log2Threshold;
+        const auto gainSlope = slope;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto overshoot = fastLog2(static_cast<float>(samples[i])) - threshold;
+            samples[i] = static_cast<SampleType>(fastExp2(juce::jmin(0.f, overshoot * gainSlope)));
+        }
+    }
+
+    template <typename To, typename From>
+    static To bitCast(From from)
+    {
+        static_assert(sizeof(To) == sizeof(From), "bitCast needs same-sized types");
+        To to;
+        std::memcpy(&to, &from, sizeof(To));
+        return to;
+    }
+
+    /** ~1e-4 absolute error (under 0.001 dB), zero and denormals come out around -127 */
+    static float fastLog2(float x)
+    {
+        auto bits = bitCast<juce::uint32>(x);
+        auto exponent = static_cast<float>(static_cast<int>((bits >> 23) & 0xff) - 127);
+        auto mantissa = bitCast<float>((bits & 0x007fffffu) | 0x3f800000u); //[1, 2)
+
+        auto poly = -0.0784406762f;
+        poly = poly * mantissa + 0.626032182f;
+        poly = poly * mantissa - 2.07833517f;
+        poly = poly * mantissa + 4.02921139f;
+        poly = poly * mantissa - 2.49835315f;
+
+        return exponent + poly;
+    }
+
+    /** ~4e-6 relative error, only ever called with x <= 0 */
+    static float fastExp2(float x)
+    {
+        x = juce::jmax(x, -126.f);
+
+        auto whole = std::floor(x);
+        auto fraction = x - whole; //[0, 1)
+
+        auto poly = 0.0136703095f;
+        poly = poly * fraction + 0.0517449978f;
+        poly = poly * fraction + 0.241604357f;
+        poly = poly * fraction + 0.692972922f;
+        poly = poly * fraction + 1.00000349f;
+
+        auto scale = bitCast<float>(static_cast<juce::uint32>(static_cast<int>(whole) + 127) << 23);
+        return poly * scale;
+    }
+};
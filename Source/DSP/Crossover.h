@@ -0,0 +1,286 @@
+/*
+  ==============================================================================
+
+    Crossover.h
+    Created: 17 Oct 2026 9:12:40am
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+ 4th order Linkwitz-Riley crossover network, same math as juce::dsp::LinkwitzRileyFilter.
+
+ Stage k splits what is left above crossover k into a low and a high part, and runs
+ the allpass compensation for every band below it at the same frequency.
+ Everything inside a stage shares one cutoff, so each (path, channel) pair gets its own
+ SIMD lane:
+
+     stage 0 (fc0):  [split L, split R]                        -> LP1 + HP1
+     stage 1 (fc1):  [allpass L, allpass R, split L, split R]  -> AP2 + LP2 + HP2
+     stage 2 (fc2):  [allpass x 2 bands, split]                 (4 bands and up)
+
+ The high output of a split comes out as allpass - lowpass, which is how
+ LinkwitzRileyFilter::processSample(channel, in, low, high) produces it too.
+
+ Frequency changes glide instead of jumping. Each stage smooths its frequency in
+ log2 (so a sweep moves at a constant rate in octaves) and refreshes its coefficients
+ every CoefficientUpdateInterval samples while gliding. tan() is never called on the
+ audio thread: g comes out of a table indexed by log2 frequency, built in prepare.
+ */
+template <typename SampleType, size_t NumBands>
+struct LinkwitzRileyCrossover
+{
+    static_assert(NumBands >= 2 && NumBands <= 8, "the crossover supports 2 to 8 bands");
+    static constexpr size_t NumCrossovers = NumBands - 1;
+
+    static constexpr int CoefficientUpdateInterval = 16;
+    static constexpr double SmoothingTimeSeconds = 0.05;
+    static constexpr float MinFrequency = 10.f;
+
+    void prepare(const juce::dsp::ProcessSpec& spec)
+    {
+        sampleRate = spec.sampleRate;
+        numChannels = static_cast<size_t>(spec.numChannels);
+
+        buildTable();
+
+        for (size_t i = 0; i < NumCrossovers; ++i)
+        {
+            auto& stage = stages[i];
+            stage.numLanes = (i + 1) * numChannels;
+
+            auto numRegisters = getNumRegisters(stage.numLanes);
+            for (auto* state : { &stage.s1, &stage.s2, &stage.s3, &stage.s4 })
+            {
+                state->assign(numRegisters, Register::expand(SampleType(0)));
+            }
+
+            //no glide into the first settings
+            stage.log2Frequency.reset(sampleRate, SmoothingTimeSeconds);
+            stage.log2Frequency.setCurrentAndTargetValue(toTablePosition(frequencies[i]));
+            updateCoefficients(stage, stage.log2Frequency.getCurrentValue());
+        }
+
+        auto maxLanes = stages.back().numLanes;
+        auto maxRegisters = getNumRegisters(maxLanes);
+
+        lanesIn.assign(maxRegisters, Register::expand(SampleType(0)));
+        lanesAllpass.assign(maxRegisters, Register::expand(SampleType(0)));
+        lanesLow.assign(maxRegisters, Register::expand(SampleType(0)));
+
+        laneReadPointers.assign(maxLanes, nullptr);
+        laneWritePointers.assign(maxLanes, nullptr);
+        highWritePointers.assign(numChannels, nullptr);
+    }
+
+    void reset()
+    {
+        for (auto& stage : stages)
+        {
+            for (auto* state : { &stage.s1, &stage.s2, &stage.s3, &stage.s4 })
+            {
+                std::fill(state->begin(), state->end(), Register::expand(SampleType(0)));
+            }
+        }
+    }
+
+    /** glides to the new frequency over SmoothingTimeSeconds once prepared */
+    void setCrossoverFrequency(size_t index, float frequency)
+    {
+        jassert(index < NumCrossovers);
+        jassert(frequency >= 0.f && frequency < static_cast<float>(sampleRate * 0.5));
+
+        frequencies[index] = frequency;
+
+        if (table.empty()) //not prepared yet, prepare() picks it up
+            return;
+
+        auto& stage = stages[index];
+        stage.log2Frequency.setTargetValue(toTablePosition(frequency));
+
+        if (! stage.log2Frequency.isSmoothing())
+            updateCoefficients(stage, stage.log2Frequency.getTargetValue());
+    }
+
+    /** input and every band must have the same number of channels and samples */
+    void process(const juce::dsp::AudioBlock<const SampleType>& input,
+                 std::array<juce::dsp::AudioBlock<SampleType>, NumBands>& bands)
+    {
+        jassert(input.getNumChannels() == numChannels);
+        for (auto& band : bands)
+        {
+            jassert(band.getNumChannels() == numChannels);
+            jassert(band.getNumSamples() == input.getNumSamples());
+            juce::ignoreUnused(band);
+        }
+
+        for (size_t i = 0; i < NumCrossovers; ++i)
+        {
+            processStage(i, input, bands);
+        }
+    }
+private:
+    using Register = juce::dsp::SIMDRegister<SampleType>;
+
+    struct Stage
+    {
+        Register g, h, R2plusG;
+        juce::LinearSmoothedValue<float> log2Frequency;
+        std::vector<Register> s1, s2, s3, s4;
+        size_t numLanes = 0;
+    };
+
+    std::array<Stage, NumCrossovers> stages;
+    std::array<float, NumCrossovers> frequencies{};
+
+    //per-sample lane scratch, sized for the widest stage
+    std::vector<Register> lanesIn, lanesAllpass, lanesLow;
+    std::vector<const SampleType*> laneReadPointers;
+    std::vector<SampleType*> laneWritePointers, highWritePointers;
+
+    double sampleRate = 44100.0;
+    size_t numChannels = 0;
+
+    //g = tan(pi * f / sampleRate), sampled evenly in log2(f) from MinFrequency up to 0.49 * sampleRate
+    static constexpr int TableSize = 1024;
+    std::vector<SampleType> table;
+    float tableStart = 0.f, tableEnd = 0.f, tableScale = 0.f;
+
+    void buildTable()
+    {
+        tableStart = std::log2(MinFrequency);
+        tableEnd = static_cast<float>(std::log2(sampleRate * 0.49));
+        tableScale = static_cast<float>(TableSize) / (tableEnd - tableStart);
+
+        table.resize(TableSize + 2); //+1 for the top entry, +1 so interpolating at the top never reads past the end
+        for (int i = 0; i <= TableSize; ++i)
+        {
+            auto frequency = std::exp2(static_cast<double>(tableStart) + i / static_cast<double>(tableScale));
+            table[static_cast<size_t>(i)] = static_cast<SampleType>(std::tan(juce::MathConstants<double>::pi * frequency / sampleRate));
+        }
+        table.back() = table[TableSize];
+    }
+
+    float toTablePosition(float frequency) const
+    {
+        return juce::jlimit(tableStart, tableEnd, std::log2(juce::jmax(frequency, MinFrequency)));
+    }
+
+    void updateCoefficients(Stage& stage, float log2Frequency)
+    {
+        auto position = (log2Frequency - tableStart) * tableScale;
+        auto index = juce::jlimit(0, TableSize, static_cast<int>(position));
+        auto fraction = static_cast<SampleType>(position - static_cast<float>(index));
+
+        auto g = table[static_cast<size_t>(index)] + fraction * (table[static_cast<size_t>(index) + 1] - table[static_cast<size_t>(index)]);
+
+        //same coefficients LinkwitzRileyFilter::update() computes
+        const auto R2 = juce::MathConstants<SampleType>::sqrt2;
+        auto h = SampleType(1) / (SampleType(1) + R2 * g + g * g);
+
+        stage.g = Register::expand(g);
+        stage.h = Register::expand(h);
+        stage.R2plusG = Register::expand(R2 + g);
+    }
+
+    void processStage(size_t index,
+                      const juce::dsp::AudioBlock<const SampleType>& input,
+                      std::array<juce::dsp::AudioBlock<SampleType>, NumBands>& bands)
+    {
+        auto& stage = stages[index];
+        const auto numSamples = input.getNumSamples();
+        const auto numAllpassLanes = index * numChannels;
+        const auto numRegisters = getNumRegisters(stage.numLanes);
+        const auto R2 = juce::MathConstants<SampleType>::sqrt2;
+
+        for (size_t ch = 0; ch < numChannels; ++ch)
+        {
+            //bands below this crossover only get phase compensated, in place
+            for (size_t band = 0; band < index; ++band)
+            {
+                auto* samples = bands[band].getChannelPointer(ch);
+                laneReadPointers[band * numChannels + ch] = samples;
+                laneWritePointers[band * numChannels + ch] = samples;
+            }
+
+            //the first split reads the input, later ones pick up the previous stage's high output
+            const SampleType* splitSource = index == 0 ? input.getChannelPointer(ch)
+                                                  : bands[index].getChannelPointer(ch);
+
+            laneReadPointers[numAllpassLanes + ch] = splitSource;
+            laneWritePointers[numAllpassLanes + ch] = bands[index].getChannelPointer(ch);
+            highWritePointers[ch] = bands[index + 1].getChannelPointer(ch);
+        }
+
+        auto* in = reinterpret_cast<SampleType*>(lanesIn.data());
+        auto* allpass = reinterpret_cast<const SampleType*>(lanesAllpass.data());
+        auto* low = reinterpret_cast<const SampleType*>(lanesLow.data());
+
+        //unused lanes in the last register may still hold a wider stage's samples
+        std::fill(in + stage.numLanes, in + numRegisters * Register::size(), SampleType(0));
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            //coefficients follow the glide in steps of CoefficientUpdateInterval samples
+            if (i % CoefficientUpdateInterval == 0 && stage.log2Frequency.isSmoothing())
+            {
+                auto numToSkip = static_cast<int>(juce::jmin(numSamples - i, static_cast<size_t>(CoefficientUpdateInterval)));
+                updateCoefficients(stage, stage.log2Frequency.skip(numToSkip));
+            }
+
+            for (size_t lane = 0; lane < stage.numLanes; ++lane)
+            {
+                in[lane] = laneReadPointers[lane][i];
+            }
+
+            for (size_t r = 0; r < numRegisters; ++r)
+            {
+                auto& s1 = stage.s1[r];
+                auto& s2 = stage.s2[r];
+                auto& s3 = stage.s3[r];
+                auto& s4 = stage.s4[r];
+
+                auto yH = (lanesIn[r] - stage.R2plusG * s1 - s2) * stage.h;
+
+                auto yB = stage.g * yH + s1;
+                s1 = stage.g * yH + yB;
+
+                auto yL = stage.g * yB + s2;
+                s2 = stage.g * yB + yL;
+
+                lanesAllpass[r] = yL - yB * R2 + yH;
+
+                auto yH2 = (yL - stage.R2plusG * s3 - s4) * stage.h;
+
+                auto yB2 = stage.g * yH2 + s3;
+                s3 = stage.g * yH2 + yB2;
+
+                auto yL2 = stage.g * yB2 + s4;
+                s4 = stage.g * yB2 + yL2;
+
+                lanesLow[r] = yL2;
+            }
+
+            for (size_t lane = 0; lane < numAllpassLanes; ++lane)
+            {
+                laneWritePointers[lane][i] = allpass[lane];
+            }
+
+            for (size_t ch = 0; ch < numChannels; ++ch)
+            {
+                auto lane = numAllpassLanes + ch;
+                laneWritePointers[lane][i] = low[lane];
+                highWritePointers[ch][i] = allpass[lane] - low[lane];
+            }
+        }
+    }
+
+    static size_t getNumRegisters(size_t numLanes)
+    {
+        return (numLanes + Register::size() - 1) / Register::size();
+    }
+};
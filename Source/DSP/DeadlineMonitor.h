@@ -0,0 +1,196 @@
+/*
+  ==============================================================================
+
+    DeadlineMonitor.h
+    Created: 17 Oct 2026 11:14:02pm
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+ Counts the blocks whose processing ate more than a set share of their real-time budget
+ (numSamples / sampleRate) and keeps the last few of them with their size and every parameter
+ value at the time. When asked to, it's saved with the plugin state, so a support ticket that
+ comes with the session shows whether the plugin was slow when the glitch happened or the host
+ dropped out on its own.
+
+ The audio thread only ever try-locks the ring, so a reader holding it costs a lost entry
+ rather than a wait. The counters are atomics and always see every block.
+ */
+struct DeadlineMonitor
+{
+    static constexpr int MaxEvents = 16;
+    static constexpr int MaxParameters = 64;
+
+    struct Event
+    {
+        juce::int64 blockIndex{ 0 };
+        juce::int64 timeMs{ 0 };
+        int numSamples{ 0 };
+        int numChannels{ 0 };
+        double sampleRate{ 0 };
+        float usedFraction{ 0 }; //of the budget, > 1 means the block was late
+
+        int numParameters{ 0 };
+        std::array<float, MaxParameters> parameters{}; //normalised
+    };
+
+    /** share of the budget above which a block counts as a miss */
+    void setThreshold(float fractionOfBudget) { threshold.store(juce::jlimit(0.05f, 2.f, fractionOfBudget)); }
+    float getThreshold() const { return threshold.load(); }
+
+    /**
+     whether the record goes into the plugin state. Off unless asked for: the counters move with
+     every block, so saving them would dirty the host session after each playback and make two
+     saves of the same preset differ.
+     */
+    void setSavedWithState(bool shouldBeSaved) { savedWithState.store(shouldBeSaved); }
+    bool isSavedWithState() const { return savedWithState.load(); }
+
+    juce::int64 getNumBlocks() const { return numBlocks.load(); }
+    juce::int64 getNumMisses() const { return numMisses.load(); }
+
+    /** audio thread, once per block with how long it took */
+    void addBlock(double elapsedSeconds, int numSamples, int numChannels, double sampleRate,
+                  const juce::Array<juce::AudioProcessorParameter*>& parameters)
+    {
+        const auto blockIndex = numBlocks.fetch_add(1);
+
+        if (numSamples <= 0 || sampleRate <= 0)
+            return;
+
+        const auto usedFraction = static_cast<float>(elapsedSeconds * sampleRate / numSamples);
+        if (usedFraction <= threshold.load(std::memory_order_relaxed))
+            return;
+
+        numMisses.fetch_add(1);
+
+        const juce::SpinLock::ScopedTryLockType lock(ringLock);
+        if (! lock.isLocked())
+            return;
+
+        auto& event = events[static_cast<size_t>(nextEvent)];
+        event.blockIndex = blockIndex;
+        event.timeMs = juce::Time::currentTimeMillis();
+        event.numSamples = numSamples;
+        event.numChannels = numChannels;
+        event.sampleRate = sampleRate;
+        event.usedFraction = usedFraction;
+
+        event.numParameters = juce::jmin(parameters.size(), MaxParameters);
+        for (int i = 0; i < event.numParameters; ++i)
+            event.parameters[static_cast<size_t>(i)] = parameters.getUnchecked(i)->getValue();
+
+        nextEvent = (nextEvent + 1) % MaxEvents;
+        numEvents = juce::jmin(numEvents + 1, MaxEvents);
+    }
+
+    /** oldest first, not for the audio thread */
+    std::vector<Event> getEvents() const
+    {
+        std::vector<Event> copy;
+        copy.reserve(MaxEvents);
+
+        const juce::SpinLock::ScopedLockType lock(ringLock);
+        for (int i = 0; i < numEvents; ++i)
+            copy.push_back(events[static_cast<size_t>((nextEvent - numEvents + i + MaxEvents) % MaxEvents)]);
+
+        return copy;
+    }
+
+    void reset()
+    {
+        const juce::SpinLock::ScopedLockType lock(ringLock);
+        numEvents = 0;
+        nextEvent = 0;
+        numBlocks.store(0);
+        numMisses.store(0);
+    }
+
+    /** the record for getStateInformation, with parameter values as the text the host would show */
+    juce::ValueTree toValueTree(const juce::Array<juce::AudioProcessorParameter*>& parameters) const
+    {
+        juce::ValueTree tree(StateType);
+        tree.setProperty("threshold", getThreshold(), nullptr);
+        tree.setProperty("blocks", getNumBlocks(), nullptr);
+        tree.setProperty("misses", getNumMisses(), nullptr);
+
+        for (const auto& event : getEvents())
+        {
+            juce::ValueTree block("Block");
+            block.setProperty("index", event.blockIndex, nullptr);
+            block.setProperty("time", juce::Time(event.timeMs).toISO8601(true), nullptr);
+            block.setProperty("timeMs", event.timeMs, nullptr);
+            block.setProperty("numSamples", event.numSamples, nullptr);
+            block.setProperty("numChannels", event.numChannels, nullptr);
+            block.setProperty("sampleRate", event.sampleRate, nullptr);
+            block.setProperty("usedFraction", event.usedFraction, nullptr);
+
+            for (int i = 0; i < juce::jmin(event.numParameters, parameters.size()); ++i)
+            {
+                auto* parameter = parameters.getUnchecked(i);
+                auto value = event.parameters[static_cast<size_t>(i)];
+
+                juce::ValueTree param("Param");
+                param.setProperty("name", parameter->getName(64), nullptr);
+                param.setProperty("value", value, nullptr);
+                param.setProperty("text", parameter->getText(value, 32), nullptr);
+                block.appendChild(param, nullptr);
+            }
+
+            tree.appendChild(block, nullptr);
+        }
+
+        return tree;
+    }
+
+    /** brings back a record saved by toValueTree, so it survives reopening the session */
+    void fromValueTree(const juce::ValueTree& tree)
+    {
+        if (! tree.hasType(StateType))
+            return;
+
+        setThreshold(tree.getProperty("threshold", getThreshold()));
+
+        const juce::SpinLock::ScopedLockType lock(ringLock);
+        numBlocks.store(static_cast<juce::int64>(tree.getProperty("blocks", 0)));
+        numMisses.store(static_cast<juce::int64>(tree.getProperty("misses", 0)));
+        numEvents = 0;
+        nextEvent = 0;
+
+        for (const auto& block : tree)
+        {
+            if (! block.hasType("Block"))
+                continue;
+
+            auto& event = events[static_cast<size_t>(nextEvent)];
+            event.blockIndex = block.getProperty("index", 0);
+            event.timeMs = block.getProperty("timeMs", 0);
+            event.numSamples = block.getProperty("numSamples", 0);
+            event.numChannels = block.getProperty("numChannels", 0);
+            event.sampleRate = block.getProperty("sampleRate", 0.0);
+            event.usedFraction = block.getProperty("usedFraction", 0.f);
+
+            event.numParameters = juce::jmin(block.getNumChildren(), MaxParameters);
+            for (int i = 0; i < event.numParameters; ++i)
+                event.parameters[static_cast<size_t>(i)] = block.getChild(i).getProperty("value", 0.f);
+
+            nextEvent = (nextEvent + 1) % MaxEvents;
+            numEvents = juce::jmin(numEvents + 1, MaxEvents);
+        }
+    }
+
+    static inline const juce::Identifier StateType{ "DeadlineMisses" };
+private:
+    std::atomic<float> threshold{ 0.8f };
+    std::atomic<juce::int64> numBlocks{ 0 }, numMisses{ 0 };
+    std::atomic<bool> savedWithState{ false };
+
+    mutable juce::SpinLock ringLock;
+    std::array<Event, MaxEvents> events{};
+    int nextEvent{ 0 }, numEvents{ 0 };
+};
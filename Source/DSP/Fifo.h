@@ -13,65 +13,150 @@
 #include <JuceHeader.h>
 
 #include <array>
-template<typename T>
+
+/** what the writer gets when every slot holds something the reader hasn't taken yet */
+enum class FullPolicy
+{
+    DropNewest,     //no slot, the new item is lost
+    OverwriteOldest //the oldest unread slot, unless the reader is inside it right now
+};
+
+/*
+ Single producer, single consumer ring of preallocated slots that are filled and read in place.
+ Nothing is copied in or out: the writer asks for a slot, fills it and publishes it, the reader
+ borrows the oldest one and hands it back. Slots keep their storage between trips, so once
+ prepare() has sized them neither side allocates.
+
+ The read position carries a flag while the reader is inside a slot. Overwriting moves the read
+ position with a compare-exchange that fails while the flag is set, so the writer can never
+ take the slot being read; it drops the new item instead.
+ */
+template<typename T, int Capacity = 32>
 struct Fifo
 {
-    void prepare(int numChannels, int numSamples)
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+        "the counters wrap at a power of two, so Capacity has to be one as well");
+
+    explicit Fifo(FullPolicy fullPolicy = FullPolicy::DropNewest) : policy(fullPolicy) {}
+
+    /** sizes every slot with prepareSlot(T&) and empties the ring. Neither side may be using it meanwhile. */
+    template <typename Fn>
+    void prepare(Fn&& prepareSlot)
     {
-        static_assert(std::is_same_v<T, juce::AudioBuffer<float>>,
-            "prepare(numChannels, numSamples) should only be used when the Fifo is holding juce::AudioBuffer<float>");
-        for (auto& buffer : buffers)
-        {
-            buffer.setSize(numChannels,
-                numSamples,
-                false,   //clear everything?
-                true,    //including the extra space?
-                true);   //avoid reallocating if you can?
-            buffer.clear();
-        }
+        for (auto& slot : slots)
+            prepareSlot(slot);
+
+        writeCount.store(0);
+        readCount.store(0);
     }
 
-    void prepare(size_t numElements)
+    //==============================================================================
+    /** writer: the slot to fill next, or nullptr when the ring is full and the policy says drop */
+    T* beginWrite()
     {
-        static_assert(std::is_same_v<T, std::vector<float>>,
-            "prepare(numElements) should only be used when the Fifo is holding std::vector<float>");
-        for (auto& buffer : buffers)
+        const auto written = writeCount.load(std::memory_order_relaxed);
+
+        for (;;)
         {
-            buffer.clear();
-            buffer.resize(numElements, 0);
+            auto read = readCount.load(std::memory_order_acquire);
+
+            if (((written - (read & CountMask)) & CountMask) < static_cast<juce::uint32>(Capacity))
+                return &slots[written & IndexMask];
+
+            if (policy == FullPolicy::DropNewest || (read & ReadingFlag) != 0)
+                break;
+
+            //the reader hasn't started on the oldest slot, so take it. Fails if it just did.
+            if (readCount.compare_exchange_weak(read, (read + 1) & CountMask, std::memory_order_acq_rel))
+            {
+                numOverwritten.store(numOverwritten.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                return &slots[written & IndexMask];
+            }
         }
+
+        numDropped.store(numDropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return nullptr;
     }
 
-    bool push(const T& t)
+    /** writer: publishes the slot beginWrite handed out */
+    void finishWrite()
     {
-        auto write = fifo.write(1);
-        if (write.blockSize1 > 0)
-        {
-            buffers[static_cast<size_t>(write.startIndex1)] = t;
-            return true;
-        }
+        writeCount.store((writeCount.load(std::memory_order_relaxed) + 1) & CountMask, std::memory_order_release);
+    }
+
+    /** writer: fill(T&) on a fresh slot, false if there was none */
+    template <typename Fn>
+    bool write(Fn&& fill)
+    {
+        auto* slot = beginWrite();
+        if (slot == nullptr)
+            return false;
 
-        return false;
+        fill(*slot);
+        finishWrite();
+        return true;
     }
 
-    bool pull(T& t)
+    //==============================================================================
+    /** reader: the oldest published slot, or nullptr when there's none. Stays put until finishRead. */
+    T* beginRead()
     {
-        auto read = fifo.read(1);
-        if (read.blockSize1 > 0)
+        auto read = readCount.load(std::memory_order_relaxed);
+        jassert((read & ReadingFlag) == 0); //one read at a time
+
+        for (;;)
         {
-            t = buffers[static_cast<size_t>(read.startIndex1)];
-            return true;
+            if (read == writeCount.load(std::memory_order_acquire))
+                return nullptr;
+
+            //reloads read if the writer just overwrote that slot
+            if (readCount.compare_exchange_weak(read, read | ReadingFlag, std::memory_order_acq_rel, std::memory_order_relaxed))
+                return &slots[read & IndexMask];
         }
+    }
+
+    /** reader: hands the slot from beginRead back to the writer */
+    void finishRead()
+    {
+        //the writer can't move the read position while the flag is set, so a plain store will do
+        const auto read = readCount.load(std::memory_order_relaxed);
+        jassert((read & ReadingFlag) != 0);
+
+        readCount.store(((read & CountMask) + 1) & CountMask, std::memory_order_release);
+    }
+
+    /** reader: use(T&) on the oldest slot, false if there was none. use may swap the contents out. */
+    template <typename Fn>
+    bool read(Fn&& use)
+    {
+        auto* slot = beginRead();
+        if (slot == nullptr)
+            return false;
 
-        return false;
+        use(*slot);
+        finishRead();
+        return true;
     }
 
+    //==============================================================================
     int getNumAvailableForReading() const
     {
-        return fifo.getNumReady();
+        const auto read = readCount.load(std::memory_order_acquire) & CountMask;
+        return static_cast<int>((writeCount.load(std::memory_order_acquire) - read) & CountMask);
     }
+
+    /** items the writer lost to a full ring, and oldest items it threw away to make room */
+    juce::uint64 getNumDropped() const { return numDropped.load(std::memory_order_relaxed); }
+    juce::uint64 getNumOverwritten() const { return numOverwritten.load(std::memory_order_relaxed); }
 private:
-    static constexpr int Capacity = 30;
-    std::array<T, Capacity> buffers;
-    juce::AbstractFifo fifo{ Capacity };
-};
\ No newline at end of file
+    static constexpr juce::uint32 ReadingFlag = 0x80000000u;
+    static constexpr juce::uint32 CountMask = ReadingFlag - 1;
+    static constexpr juce::uint32 IndexMask = static_cast<juce::uint32>(Capacity - 1);
+
+    const FullPolicy policy;
+    std::array<T, Capacity> slots;
+
+    //free-running counts of published and consumed items, modulo 2^31
+    std::atomic<juce::uint32> writeCount{ 0 }, readCount{ 0 };
+    std::atomic<juce::uint64> numDropped{ 0 }, numOverwritten{ 0 };
+};
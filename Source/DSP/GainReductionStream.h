@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+
+    GainReductionStream.h
+    Created: 18 Oct 2026 12:21:44am
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+ One band's gain reduction on its way to the editor: the lowest gain of every
+ DecimationSamples-sample stretch (across all channels), so a transient that clamps down for a
+ few samples still shows up.
+
+ Single producer (whichever thread compresses the band), single consumer (the editor). Pushing
+ never waits: when the editor isn't draining, e.g. because it's closed, new values are dropped
+ once the ring is full.
+ */
+struct GainReductionStream
+{
+    static constexpr int DecimationSamples = 32;
+
+    //a few seconds at 48kHz, more than the editor ever falls behind
+    static constexpr int Capacity = 8192;
+
+    /** audio side: gains at samplesPerValue per output value, or nullptr for a stretch with no reduction */
+    template <typename SampleType>
+    void addGains(const juce::AudioBuffer<SampleType>* gains, int numChannels, int numSamples, int samplesPerValue)
+    {
+        for (int start = 0; start < numSamples;)
+        {
+            //zero when the rate just dropped below what was already held, which then goes out as is
+            const auto count = juce::jmax(0, juce::jmin(samplesPerValue - heldSamples, numSamples - start));
+
+            if (gains != nullptr && count > 0)
+            {
+                for (int ch = 0; ch < numChannels; ++ch)
+                {
+                    auto lowest = juce::FloatVectorOperations::findMinimum(gains->getReadPointer(ch, start), count);
+                    heldGain = juce::jmin(heldGain, static_cast<float>(lowest));
+                }
+            }
+
+            heldSamples += count;
+            start += count;
+
+            if (heldSamples >= samplesPerValue)
+            {
+                push(heldGain);
+                heldGain = 1.f;
+                heldSamples = 0;
+            }
+        }
+    }
+
+    /** audio side, drops whatever was half collected */
+    void reset()
+    {
+        heldGain = 1.f;
+        heldSamples = 0;
+    }
+
+    /** editor side, copies up to maxValues linear gains oldest first and returns how many */
+    int pull(float* dest, int maxValues)
+    {
+        const auto scope = fifo.read(juce::jmin(maxValues, fifo.getNumReady()));
+
+        if (scope.blockSize1 > 0)
+            std::copy_n(values.begin() + scope.startIndex1, scope.blockSize1, dest);
+
+        if (scope.blockSize2 > 0)
+            std::copy_n(values.begin() + scope.startIndex2, scope.blockSize2, dest + scope.blockSize1);
+
+        return scope.blockSize1 + scope.blockSize2;
+    }
+
+    /** editor side, skips the backlog that built up while nobody was reading */
+    void discardPending() { fifo.finishedRead(fifo.getNumReady()); }
+private:
+    std::array<float, Capacity> values{};
+    juce::AbstractFifo fifo{ Capacity };
+
+    float heldGain{ 1.f };
+    int heldSamples{ 0 };
+
+    void push(float gain)
+    {
+        const auto scope = fifo.write(1);
+
+        if (scope.blockSize1 > 0)
+            values[static_cast<size_t>(scope.startIndex1)] = gain;
+    }
+};
@@ -0,0 +1,268 @@
+/*
+  ==============================================================================
+
+    LinearPhaseCrossover.h
+    Created: 17 Oct 2026 1:41:09pm
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+ Linear-phase alternative to LinkwitzRileyCrossover.
+
+ Every band is its own symmetric FIR kernel, built from windowed-sinc lowpasses at the
+ crossover frequencies:
+
+     band 0      = LP(fc0)
+     band k      = LP(fck) - LP(fck-1)
+     last band   = delta - LP(fcN-2)
+
+ so the bands add back up to a pure delay of (kernelLength - 1) / 2 samples.
+
+ The kernels run through juce::dsp::Convolution, which does uniformly partitioned FFT
+ convolution, so the cost follows the FFT size rather than the kernel length.
+ prepare() installs the first kernels before it returns. When a crossover moves later on, the
+ kernels are rebuilt on a background thread and handed to the convolutions, which swap them
+ in (with a short crossfade) from their own lock-free queue.
+
+ juce::dsp::Convolution only runs in float, so the double version converts through
+ float scratch buffers on the way in and out. It also only handles one or two channels,
+ so wider buses get a set of convolutions per channel pair.
+ */
+template <typename SampleType, size_t NumBands>
+struct LinearPhaseCrossover
+{
+    static constexpr size_t NumCrossovers = NumBands - 1;
+
+    ~LinearPhaseCrossover()
+    {
+        designer.stopThread(1000);
+    }
+
+    void prepare(const juce::dsp::ProcessSpec& spec)
+    {
+        designer.stopThread(1000);
+
+        sampleRate = spec.sampleRate;
+
+        //90ms of kernel at any rate (45ms of latency), odd so the group delay is a whole number
+        //of samples. Only the convolutions' FFTs get padded to a power of two, not the kernel.
+        kernelLength = static_cast<int>(std::round(sampleRate * 0.09)) | 1;
+
+        const auto numChannels = static_cast<size_t>(spec.numChannels);
+        convolutions.resize((numChannels + 1) / 2);
+
+        for (auto& pair : convolutions)
+            for (auto& convolution : pair)
+                if (convolution == nullptr)
+                    convolution = std::make_unique<juce::dsp::Convolution>(queue);
+
+        //loadImpulseResponse only queues the kernels, and Convolution::prepare runs whatever is
+        //queued before it builds its engine. So designing first means the very first block goes
+        //through the real kernels, rather than the default IR until the queue thread gets to them.
+        //Whatever crossover change was pending is in these, so the designer mustn't redo them.
+        kernelsNeedUpdating.store(false);
+        designKernels();
+
+        for (size_t pair = 0; pair < convolutions.size(); ++pair)
+        {
+            auto pairSpec = spec;
+            pairSpec.numChannels = static_cast<juce::uint32>(juce::jmin(size_t{ 2 }, numChannels - pair * 2));
+
+            for (auto& convolution : convolutions[pair])
+                convolution->prepare(pairSpec);
+        }
+
+        if constexpr (! std::is_same_v<SampleType, float>)
+        {
+            const auto numChannels = static_cast<int>(spec.numChannels);
+            const auto maxBlockSize = static_cast<int>(spec.maximumBlockSize);
+
+            inputScratch.setSize(numChannels, maxBlockSize, false, true, false);
+            for (auto& scratch : bandScratch)
+                scratch.setSize(numChannels, maxBlockSize, false, true, false);
+        }
+
+        designer.startThread();
+    }
+
+    void reset()
+    {
+        for (auto& pair : convolutions)
+            for (auto& convolution : pair)
+                convolution->reset();
+    }
+
+    /** safe to call from the audio thread, the kernels are rebuilt on the designer thread */
+    void setCrossoverFrequency(size_t index, float frequency)
+    {
+        jassert(index < NumCrossovers);
+
+        if (frequencies[index].exchange(frequency) != frequency)
+            kernelsNeedUpdating.store(true);
+    }
+
+    int getLatencySamples() const { return (kernelLength - 1) / 2; }
+
+    /** input and every band must have the same number of channels and samples */
+    void process(const juce::dsp::AudioBlock<const SampleType>& input,
+                 std::array<juce::dsp::AudioBlock<SampleType>, NumBands>& bands)
+    {
+        if constexpr (std::is_same_v<SampleType, float>)
+        {
+            convolve(input, bands);
+        }
+        else
+        {
+            const auto numSamples = input.getNumSamples();
+            jassert(numSamples <= static_cast<size_t>(inputScratch.getNumSamples()));
+
+            auto floatInput = juce::dsp::AudioBlock<float>(inputScratch).getSubBlock(0, numSamples);
+            convert(input, floatInput);
+
+            std::array<juce::dsp::AudioBlock<float>, NumBands> floatBands;
+            for (size_t band = 0; band < NumBands; ++band)
+                floatBands[band] = juce::dsp::AudioBlock<float>(bandScratch[band]).getSubBlock(0, numSamples);
+
+            convolve(floatInput, floatBands);
+
+            for (size_t band = 0; band < NumBands; ++band)
+                convert(floatBands[band], bands[band]);
+        }
+    }
+private:
+    juce::dsp::ConvolutionMessageQueue queue;
+
+    //one set of band convolutions per channel pair
+    std::vector<std::array<std::unique_ptr<juce::dsp::Convolution>, NumBands>> convolutions;
+
+    std::array<std::atomic<float>, NumCrossovers> frequencies{};
+    std::atomic<bool> kernelsNeedUpdating{ false };
+
+    double sampleRate = 44100.0;
+    int kernelLength = 0;
+
+    //only allocated for double
+    juce::AudioBuffer<float> inputScratch;
+    std::array<juce::AudioBuffer<float>, NumBands> bandScratch;
+
+    void convolve(const juce::dsp::AudioBlock<const float>& input,
+                  std::array<juce::dsp::AudioBlock<float>, NumBands>& bands)
+    {
+        const auto numChannels = input.getNumChannels();
+
+        for (size_t pair = 0; pair < convolutions.size() && pair * 2 < numChannels; ++pair)
+        {
+            const auto firstChannel = pair * 2;
+            const auto pairChannels = juce::jmin(size_t{ 2 }, numChannels - firstChannel);
+            auto pairInput = input.getSubsetChannelBlock(firstChannel, pairChannels);
+
+            for (size_t band = 0; band < NumBands; ++band)
+            {
+                auto pairBand = bands[band].getSubsetChannelBlock(firstChannel, pairChannels);
+                convolutions[pair][band]->process(juce::dsp::ProcessContextNonReplacing<float>(pairInput, pairBand));
+            }
+        }
+    }
+
+    template <typename From, typename To>
+    static void convert(const juce::dsp::AudioBlock<From>& source, const juce::dsp::AudioBlock<To>& dest)
+    {
+        const auto numChannels = juce::jmin(source.getNumChannels(), dest.getNumChannels());
+        const auto numSamples = juce::jmin(source.getNumSamples(), dest.getNumSamples());
+
+        for (size_t ch = 0; ch < numChannels; ++ch)
+        {
+            auto* src = source.getChannelPointer(ch);
+            auto* dst = dest.getChannelPointer(ch);
+
+            for (size_t i = 0; i < numSamples; ++i)
+                dst[i] = static_cast<To>(src[i]);
+        }
+    }
+
+    struct KernelDesigner : juce::Thread
+    {
+        KernelDesigner(LinearPhaseCrossover& c) : juce::Thread("Linear phase kernel designer"), owner(c) { }
+
+        void run() override
+        {
+            while (! threadShouldExit())
+            {
+                //polled rather than notified, so the audio thread never touches a lock
+                if (owner.kernelsNeedUpdating.exchange(false))
+                    owner.designKernels();
+
+                wait(20);
+            }
+        }
+
+        LinearPhaseCrossover& owner;
+    };
+
+    KernelDesigner designer{ *this };
+
+    void designKernels()
+    {
+        const auto centre = (kernelLength - 1) / 2;
+
+        std::array<std::vector<float>, NumCrossovers> lowpasses;
+        for (size_t i = 0; i < NumCrossovers; ++i)
+            lowpasses[i] = designLowpass(frequencies[i].load());
+
+        for (size_t band = 0; band < NumBands; ++band)
+        {
+            juce::AudioBuffer<float> kernel(1, kernelLength);
+            kernel.clear();
+            auto* taps = kernel.getWritePointer(0);
+
+            if (band < NumCrossovers)
+                juce::FloatVectorOperations::copy(taps, lowpasses[band].data(), kernelLength);
+            else
+                taps[centre] = 1.f;
+
+            if (band > 0)
+                juce::FloatVectorOperations::subtract(taps, lowpasses[band - 1].data(), kernelLength);
+
+            for (auto& pair : convolutions)
+            {
+                pair[band]->loadImpulseResponse(juce::AudioBuffer<float>(kernel),
+                                                sampleRate,
+                                                juce::dsp::Convolution::Stereo::no,
+                                                juce::dsp::Convolution::Trim::no,
+                                                juce::dsp::Convolution::Normalise::no);
+            }
+        }
+    }
+
+    /** Blackman windowed sinc, scaled to unity gain at DC */
+    std::vector<float> designLowpass(float cutoff) const
+    {
+        std::vector<float> taps(static_cast<size_t>(kernelLength));
+        const auto centre = (kernelLength - 1) / 2;
+        const auto normalisedCutoff = 2.0 * juce::jlimit(1.0, sampleRate * 0.49, static_cast<double>(cutoff)) / sampleRate;
+
+        auto sum = 0.0;
+        for (int n = 0; n < kernelLength; ++n)
+        {
+            auto x = static_cast<double>(n - centre);
+            auto sinc = x == 0.0 ? normalisedCutoff
+                                 : std::sin(juce::MathConstants<double>::pi * normalisedCutoff * x) / (juce::MathConstants<double>::pi * x);
+
+            auto phase = juce::MathConstants<double>::twoPi * n / (kernelLength - 1);
+            auto window = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+
+            taps[static_cast<size_t>(n)] = static_cast<float>(sinc * window);
+            sum += sinc * window;
+        }
+
+        for (auto& tap : taps)
+            tap = static_cast<float>(tap / sum);
+
+        return taps;
+    }
+};
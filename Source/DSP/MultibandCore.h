@@ -0,0 +1,440 @@
+/*
+  ==============================================================================
+
+    MultibandCore.h
+    Created: 17 Oct 2026 11:20:52am
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "CompressorBand.h"
+#include "Crossover.h"
+#include "LinearPhaseCrossover.h"
+#include "BandMixer.h"
+#include "BandWorkerPool.h"
+#include "BlockDelayLine.h"
+#include "StageProfiler.h"
+
+/*
+ Input gain -> split -> compress -> mix, for a band count fixed at compile time.
+ The crossover cascade and its allpass compensation come from LinkwitzRileyCrossover
+ (or LinearPhaseCrossover in linear-phase mode), and the per-band steps are expanded with forEachBand so there is no loop or indirection left
+ over the bands themselves.
+ Everything runs at SampleType, the processor keeps a float and a double instance.
+
+ Buffers are sized for getSubBlockSize() whatever the host announced, and process() must be
+ handed at most that many samples: the processor walks each host block in pieces that size,
+ so oversized or irregular host blocks never reach the DSP and nothing is ever reallocated.
+ */
+template <typename SampleType, size_t NumBands>
+struct MultibandCore
+{
+    static_assert(NumBands >= 2 && NumBands <= 8, "MultibandCore supports 2 to 8 bands");
+    static constexpr size_t NumCrossovers = NumBands - 1;
+
+    static constexpr float SilenceThreshold = 1.0e-6f; //-120dB
+
+    //channel-samples per block below which handing bands to other threads costs more than it saves
+    static constexpr int MinParallelWorkload = 2048;
+
+    //serial sub-block, every band's working buffers fit in L1 together
+    static constexpr int InternalBlockSize = 64;
+
+    //with the bands spread over cores each has its own L1, and bigger pieces keep the hand-off rare.
+    //Linear-phase mode uses it too: the convolutions run a whole FFT per call however few samples
+    //they're given, so 64-sample pieces would cost them 16 times over.
+    static constexpr int ParallelBlockSize = 1024;
+
+    std::array<CompressorBand<SampleType>, NumBands> compressors;
+
+    void prepare(const juce::dsp::ProcessSpec& hostSpec)
+    {
+        //the host's block size doesn't matter, process() only ever sees sub-blocks
+        auto spec = hostSpec;
+        spec.maximumBlockSize = static_cast<juce::uint32>(juce::jmax(InternalBlockSize, ParallelBlockSize));
+
+        maxBlockSize = static_cast<int>(spec.maximumBlockSize);
+        sampleRate = spec.sampleRate;
+
+        forEachBand([&](auto band)
+        {
+            compressors[band].prepare(spec);
+
+            //allocated once here, splitBands never grows them
+            filterBuffers[band].setSize(static_cast<int>(spec.numChannels), maxBlockSize, false, true, false);
+        });
+
+        crossover.prepare(spec);
+        linearPhaseCrossover.prepare(spec);
+
+        //the sidechain only feeds detectors, so it is summed to one channel and split once
+        auto keySpec = spec;
+        keySpec.numChannels = 1;
+        keyCrossover.prepare(keySpec);
+        keyBuffer.setSize(1, maxBlockSize, false, true, false);
+
+        //the key split is minimum-phase, in linear-phase mode it waits for the audio's kernels to catch up.
+        //That's 45ms at any rate, well past the 10ms lookahead, which delays the audio anyway, not the key.
+        keyDelay.prepare(1, linearPhaseCrossover.getLatencySamples(), maxBlockSize);
+        keyDelay.setDelay(linearPhaseCrossover.getLatencySamples());
+        for (auto& keyBand : keyBands)
+            keyBand.setSize(1, maxBlockSize, false, true, false);
+
+        inputGain.prepare(spec);
+        mixer.prepare(spec);
+
+        //the most work a parallel sub-block can carry, with the host's blocks as announced
+        maxParallelWorkload = juce::jmin(static_cast<int>(hostSpec.maximumBlockSize), ParallelBlockSize) * static_cast<int>(spec.numChannels);
+        updateWorkers(parallelBands);
+
+        alignBands();
+
+        silentSamples = 0;
+        isIdle = false;
+    }
+
+    /** clears every filter, envelope and delay line */
+    void reset()
+    {
+        forEachBand([this](auto band) { compressors[band].reset(); });
+
+        crossover.reset();
+        linearPhaseCrossover.reset();
+        keyCrossover.reset();
+        keyDelay.reset();
+        inputGain.reset();
+        mixer.reset();
+    }
+
+    void setCrossoverFrequency(size_t index, float frequency)
+    {
+        if (! crossoverSnapshots[index].update(frequency))
+            return;
+
+        crossover.setCrossoverFrequency(index, frequency);
+        linearPhaseCrossover.setCrossoverFrequency(index, frequency);
+        keyCrossover.setCrossoverFrequency(index, frequency);
+
+        updateTailSamples();
+    }
+
+    void setLinearPhase(bool shouldBeLinearPhase)
+    {
+        if (linearPhase == shouldBeLinearPhase)
+            return;
+
+        linearPhase = shouldBeLinearPhase;
+
+        //whichever crossover takes over starts from silence rather than from stale state
+        if (linearPhase)
+        {
+            linearPhaseCrossover.reset();
+            keyDelay.reset();
+        }
+        else
+        {
+            crossover.reset();
+        }
+
+        updateTailSamples();
+    }
+
+    /**
+     the IIR crossover adds no latency, the linear-phase one delays every band by half its kernel.
+     On top of that comes the slowest band's oversampling.
+     */
+    int getLatencySamples() const
+    {
+        auto crossoverLatency = linearPhase ? linearPhaseCrossover.getLatencySamples() : 0;
+        return crossoverLatency + bandLatencySamples;
+    }
+
+    /**
+     how long the output keeps going after the input stops.
+     The FIR parts (oversampling filters, linear-phase kernels) ring for up to twice their latency,
+     and the lowest Linkwitz-Riley stage needs about RingCycles periods of its cutoff to fall 120dB.
+     Worked out whenever the latency or a crossover changes, process() checks it every sub-block.
+     */
+    int getTailSamples() const { return tailSamples.load(std::memory_order_relaxed); }
+
+    void setInputGainDecibels(float gainDecibels)
+    {
+        if (inputGainSnapshot.update(gainDecibels))
+            inputGain.setGainDecibels(static_cast<SampleType>(gainDecibels));
+    }
+
+    void setOutputGainDecibels(float gainDecibels)
+    {
+        if (outputGainSnapshot.update(gainDecibels))
+            mixer.setGainDecibels(gainDecibels);
+    }
+
+    /** meter ballistics for every band, see BandMeter */
+    void setMetering(float rmsWindowMs, float peakReleaseDbPerSecond, bool measureTruePeak)
+    {
+        forEachBand([&](auto band) { compressors[band].setMetering(rmsWindowMs, peakReleaseDbPerSecond, measureTruePeak); });
+    }
+
+    /** stage timings of the current host block go here when set, the profiler has to outlive the core */
+    void setProfiler(StageProfiler* newProfiler) { profiler = newProfiler; }
+
+    /** compresses the bands on the worker pool when the block is big enough to be worth it */
+    void setParallelBands(bool shouldRunInParallel) { parallelBands = shouldRunInParallel; }
+
+    /**
+     message thread (or prepare): spawns the workers if parallel bands are wanted and the blocks
+     are big enough to ever reach MinParallelWorkload, and stops them otherwise.
+     Until they're up, process() compresses every band on the audio thread.
+     */
+    void updateWorkers(bool parallelBandsWanted)
+    {
+        //the audio thread compresses one band itself, so one worker per remaining band at most
+        const auto numWorkers = parallelBandsWanted && maxParallelWorkload >= MinParallelWorkload
+                              ? juce::jmin(static_cast<int>(NumBands) - 1, juce::SystemStats::getNumCpus() - 1)
+                              : 0;
+
+        if (workers.getNumWorkers() == numWorkers)
+            return;
+
+        if (numWorkers > 0)
+            workers.start(numWorkers);
+        else
+            workers.stop();
+    }
+
+    /** the most samples process() takes at once, for the current mode */
+    int getSubBlockSize() const { return parallelBands || linearPhase ? ParallelBlockSize : InternalBlockSize; }
+
+    void setGainRampDurationSeconds(double seconds)
+    {
+        inputGain.setRampDurationSeconds(seconds);
+        mixer.setRampDurationSeconds(seconds);
+    }
+
+    void updateCompressorSettings()
+    {
+        auto latencyChanged = false;
+        forEachBand([&](auto band) { latencyChanged |= compressors[band].updateCompressorSettings(); });
+
+        if (latencyChanged)
+            alignBands();
+    }
+
+    /**
+     Once the input has been silent for longer than the tail and the output has died away,
+     the state is cleared and blocks of silence skip the DSP. The first block that isn't
+     silent runs in full from that cleared state, so processing picks up on its first sample.
+
+     With a sidechain, each band's detector listens to the matching band of the key instead.
+     The key counts towards the silence too, so a key that is still ducking keeps the detectors
+     running through a gap in the main input.
+     */
+    void process(juce::AudioBuffer<SampleType>& buffer, const juce::AudioBuffer<SampleType>* sidechain = nullptr)
+    {
+        const auto numSamples = buffer.getNumSamples();
+        jassert(numSamples <= maxBlockSize);
+
+        const auto useKey = sidechain != nullptr && sidechain->getNumChannels() > 0;
+        const auto inputIsSilent = buffer.getMagnitude(0, numSamples) < SilenceThreshold
+                                && (! useKey || sidechain->getMagnitude(0, numSamples) < SilenceThreshold);
+
+        silentSamples = inputIsSilent ? juce::jmin(silentSamples + numSamples, std::numeric_limits<int>::max() / 2) : 0;
+
+        if (isIdle)
+        {
+            if (inputIsSilent)
+            {
+                buffer.clear();
+
+                //nothing gets compressed, but the editor's gain reduction history should read 0dB, not freeze
+                forEachBand([&](auto band) { compressors[band].addIdleGains(numSamples); });
+                return;
+            }
+
+            isIdle = false;
+        }
+
+        {
+            StageProfiler::ScopedStage stage(profiler, StageProfiler::InputGain);
+            auto block = juce::dsp::AudioBlock<SampleType>(buffer);
+            inputGain.process(juce::dsp::ProcessContextReplacing<SampleType>(block));
+        }
+
+        {
+            StageProfiler::ScopedStage stage(profiler, StageProfiler::SplitBands);
+            splitBands(buffer);
+
+            if (useKey)
+                splitKey(*sidechain);
+        }
+
+        //after the split every band is independent until the mix
+        auto compressBand = [&](int band)
+        {
+            StageProfiler::ScopedStage stage(profiler, StageProfiler::CompressBand + band);
+            auto index = static_cast<size_t>(band);
+            compressors[index].process(filterBuffers[index], useKey ? keyBands[index].getReadPointer(0) : nullptr);
+        };
+
+        if (parallelBands && numSamples * buffer.getNumChannels() >= MinParallelWorkload)
+            workers.run(static_cast<int>(NumBands), compressBand);
+        else
+            forEachBand([&](auto band) { compressBand(static_cast<int>(band)); });
+
+        {
+            StageProfiler::ScopedStage stage(profiler, StageProfiler::Mix);
+            mixer.process(buffer, filterBuffers, getBandMask());
+        }
+
+        //silentSamples only runs while the key is quiet as well
+        if (silentSamples > tailSamples.load(std::memory_order_relaxed) && buffer.getMagnitude(0, numSamples) < SilenceThreshold)
+        {
+            reset();
+            isIdle = true;
+        }
+    }
+
+    bool isIdling() const { return isIdle; }
+
+    /** calls fn(std::integral_constant<size_t, band>) for every band, expanded at compile time */
+    template <typename Fn>
+    static void forEachBand(Fn&& fn)
+    {
+        forEachBandImpl(fn, std::make_index_sequence<NumBands>());
+    }
+private:
+    LinkwitzRileyCrossover<SampleType, NumBands> crossover;
+    LinearPhaseCrossover<SampleType, NumBands> linearPhaseCrossover;
+    bool linearPhase = false;
+    int bandLatencySamples = 0;
+
+    juce::dsp::Gain<SampleType> inputGain;
+    BandMixer<SampleType, NumBands> mixer;
+
+    std::array<ParamSnapshot<float>, NumBands - 1> crossoverSnapshots;
+    ParamSnapshot<float> inputGainSnapshot, outputGainSnapshot;
+
+    std::array<juce::AudioBuffer<SampleType>, NumBands> filterBuffers;
+
+    LinkwitzRileyCrossover<SampleType, NumBands> keyCrossover;
+    juce::AudioBuffer<SampleType> keyBuffer;
+    BlockDelayLine<SampleType> keyDelay;
+    std::array<juce::AudioBuffer<SampleType>, NumBands> keyBands;
+    int maxBlockSize{ 0 };
+    double sampleRate{ 44100.0 };
+
+    BandWorkerPool workers;
+    bool parallelBands{ false };
+    int maxParallelWorkload{ 0 };
+
+    StageProfiler* profiler{ nullptr };
+
+    static constexpr double RingCycles = 3.1;
+    std::atomic<int> tailSamples{ 0 }; //the host asks from any thread
+    int silentSamples{ 0 };
+    bool isIdle{ false };
+
+    void alignBands()
+    {
+        //the slowest band sets the pace, everything else gets delayed to line up with it
+        auto latency = 0;
+        forEachBand([&](auto band) { latency = juce::jmax(latency, compressors[band].getLatencySamples()); });
+        forEachBand([&](auto band) { compressors[band].setAlignmentLatency(latency); });
+
+        bandLatencySamples = latency;
+        updateTailSamples();
+    }
+
+    void updateTailSamples()
+    {
+        auto lowestCrossover = std::numeric_limits<float>::max();
+        for (const auto& snapshot : crossoverSnapshots)
+            lowestCrossover = juce::jmin(lowestCrossover, snapshot.get());
+
+        auto ringSamples = static_cast<int>(std::ceil(RingCycles * sampleRate / juce::jmax(lowestCrossover, 10.f)));
+        tailSamples.store(2 * getLatencySamples() + ringSamples, std::memory_order_relaxed);
+    }
+
+    template <typename Fn, size_t... Bands>
+    static void forEachBandImpl(Fn& fn, std::index_sequence<Bands...>)
+    {
+        (fn(std::integral_constant<size_t, Bands>()), ...);
+    }
+
+    void splitBands(const juce::AudioBuffer<SampleType>& inputBuffer)
+    {
+        auto numSamples = inputBuffer.getNumSamples();
+        jassert(numSamples <= maxBlockSize);
+
+        std::array<juce::dsp::AudioBlock<SampleType>, NumBands> bandBlocks;
+
+        forEachBand([&](auto band)
+        {
+            auto& fb = filterBuffers[band];
+
+            //shrinking only moves the end marker, the storage from prepare is kept
+            fb.setSize(fb.getNumChannels(), numSamples, false, false, true);
+            bandBlocks[band] = juce::dsp::AudioBlock<SampleType>(fb);
+        });
+
+        //every stage writes straight into the band it feeds, so nothing gets copied up front
+        auto inputBlock = juce::dsp::AudioBlock<const SampleType>(inputBuffer);
+
+        if (linearPhase)
+            linearPhaseCrossover.process(inputBlock, bandBlocks);
+        else
+            crossover.process(inputBlock, bandBlocks);
+    }
+
+    void splitKey(const juce::AudioBuffer<SampleType>& sidechain)
+    {
+        const auto numSamples = sidechain.getNumSamples();
+        const auto numChannels = sidechain.getNumChannels();
+        jassert(numSamples <= maxBlockSize);
+
+        keyBuffer.setSize(1, numSamples, false, false, true);
+        keyBuffer.copyFrom(0, 0, sidechain, 0, 0, numSamples);
+        for (int ch = 1; ch < numChannels; ++ch)
+            keyBuffer.addFrom(0, 0, sidechain, ch, 0, numSamples);
+
+        if (numChannels > 1)
+            keyBuffer.applyGain(static_cast<SampleType>(1) / static_cast<SampleType>(numChannels));
+
+        //lines the key up with the audio coming out of the linear-phase kernels
+        if (linearPhase)
+            keyDelay.process(juce::dsp::AudioBlock<SampleType>(keyBuffer));
+
+        std::array<juce::dsp::AudioBlock<SampleType>, NumBands> bandBlocks;
+        forEachBand([&](auto band)
+        {
+            keyBands[band].setSize(1, numSamples, false, false, true);
+            bandBlocks[band] = juce::dsp::AudioBlock<SampleType>(keyBands[band]);
+        });
+
+        keyCrossover.process(juce::dsp::AudioBlock<const SampleType>(keyBuffer), bandBlocks);
+    }
+
+    std::array<float, NumBands> getBandMask() const
+    {
+        std::array<bool, NumBands> soloed, muted;
+        forEachBand([&](auto band)
+        {
+            soloed[band] = compressors[band].Solo->get();
+            muted[band] = compressors[band].Mute->get();
+        });
+
+        auto bandsAreSoloed = std::find(soloed.begin(), soloed.end(), true) != soloed.end();
+
+        std::array<float, NumBands> mask;
+        forEachBand([&](auto band)
+        {
+            auto isAudible = bandsAreSoloed ? soloed[band] : ! muted[band];
+            mask[band] = isAudible ? 1.f : 0.f;
+        });
+
+        return mask;
+    }
+};
@@ -0,0 +1,39 @@
+/*
+  ==============================================================================
+
+    ParamSnapshot.h
+    Created: 17 Oct 2026 5:10:44pm
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+ Last value the audio thread applied for one parameter.
+ update() returns true only when the value moved, so a coefficient gets recomputed
+ when its control changes rather than on every block.
+ */
+template <typename ValueType>
+struct ParamSnapshot
+{
+    bool update(ValueType newValue)
+    {
+        if (hasValue && newValue == value)
+            return false;
+
+        value = newValue;
+        hasValue = true;
+        return true;
+    }
+
+    /** the next update() reports a change whatever the value, e.g. after the sample rate moved */
+    void invalidate() { hasValue = false; }
+
+    ValueType get() const { return value; }
+private:
+    ValueType value{};
+    bool hasValue = false;
+};
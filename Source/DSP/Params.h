@@ -13,6 +13,14 @@
 
 namespace Params
 {
+    constexpr size_t NumBands = 3;
+
+    //the ratio choice list, the compressors index this directly instead of parsing the choice names
+    constexpr std::array<float, 14> RatioChoices{ 1.f, 1.5f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f, 10.f, 20.f, 50.f, 100.f };
+
+    //channels per detector for the Off / Pairs / All link choices, the kernel clamps to the bus width
+    constexpr std::array<int, 3> LinkGroupSizes{ 1, 2, 16 };
+
     enum names
     {
         //Crossover parameters
@@ -49,9 +57,46 @@ namespace Params
         Solo_High_Band,
 
         Gain_in,
-        Gain_out
+        Gain_out,
+
+        Linear_Phase_Crossover,
+
+        Oversampling_Low_Band,
+        Oversampling_Mid_Band,
+        Oversampling_High_Band,
+
+        Lookahead_Low_Band,
+        Lookahead_Mid_Band,
+        Lookahead_High_Band,
+
+        Detector_Link,
+
+        External_Sidechain,
+
+        Parallel_Bands
     };
 
+    static_assert(Threshold_High_Band - Threshold_Low_Band + 1 == NumBands
+               && Solo_High_Band - Solo_Low_Band + 1 == NumBands
+               && Oversampling_High_Band - Oversampling_Low_Band + 1 == NumBands
+               && Lookahead_High_Band - Lookahead_Low_Band + 1 == NumBands
+               && Mid_High_Crossover_Freq - Low_Mid_Crossover_Freq + 2 == NumBands,
+                  "the per-band parameters need one entry per band, ordered low to high");
+
+    /** per-band parameters are laid out low to high, so band i of Attack is Attack_Low_Band + i */
+    inline names getBandParam(names lowBandParam, size_t band)
+    {
+        jassert(band < NumBands);
+        return static_cast<names>(lowBandParam + static_cast<int>(band));
+    }
+
+    /** crossover i sits between band i and band i + 1 */
+    inline names getCrossoverParam(size_t crossover)
+    {
+        jassert(crossover < NumBands - 1);
+        return static_cast<names>(Low_Mid_Crossover_Freq + static_cast<int>(crossover));
+    }
+
     inline const std::map <names, juce::String>& GetParams()
     {
         static std::map<names, juce::String> params =
@@ -80,7 +125,17 @@ namespace Params
             {Solo_Mid_Band, "Solo Mid Band"},
             {Solo_High_Band, "Solo High Band"},
             {Gain_in, "Gain In"},
-            {Gain_out, "Gain Out"}
+            {Gain_out, "Gain Out"},
+            {Linear_Phase_Crossover, "Linear Phase Crossover"},
+            {Oversampling_Low_Band, "Oversampling Low Band"},
+            {Oversampling_Mid_Band, "Oversampling Mid Band"},
+            {Oversampling_High_Band, "Oversampling High Band"},
+            {Lookahead_Low_Band, "Lookahead Low Band"},
+            {Lookahead_Mid_Band, "Lookahead Mid Band"},
+            {Lookahead_High_Band, "Lookahead High Band"},
+            {Detector_Link, "Detector Link"},
+            {External_Sidechain, "External Sidechain"},
+            {Parallel_Bands, "Parallel Bands"}
         };
 
         return params;
@@ -0,0 +1,83 @@
+/*
+  ==============================================================================
+
+    Semaphore.cpp
+    Created: 19 Oct 2026 10:12:44am
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#include "Semaphore.h"
+
+#if JUCE_WINDOWS
+ #include <windows.h>
+#elif JUCE_MAC || JUCE_IOS
+ #include <dispatch/dispatch.h>
+#else
+ #include <semaphore.h>
+ #include <cerrno>
+#endif
+
+#if JUCE_WINDOWS
+struct Semaphore::Pimpl
+{
+    Pimpl() : handle(CreateSemaphoreW(nullptr, 0, 0x7fffffff, nullptr)) { jassert(handle != nullptr); }
+    ~Pimpl() { CloseHandle(handle); }
+
+    void post(int count) { ReleaseSemaphore(handle, count, nullptr); }
+    void wait() { WaitForSingleObject(handle, INFINITE); }
+
+    HANDLE handle;
+};
+#elif JUCE_MAC || JUCE_IOS
+struct Semaphore::Pimpl
+{
+    Pimpl() : semaphore(dispatch_semaphore_create(0)) { jassert(semaphore != nullptr); }
+    ~Pimpl() { dispatch_release(semaphore); }
+
+    void post(int count)
+    {
+        for (int i = 0; i < count; ++i)
+            dispatch_semaphore_signal(semaphore);
+    }
+
+    void wait() { dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER); }
+
+    dispatch_semaphore_t semaphore;
+};
+#else
+struct Semaphore::Pimpl
+{
+    Pimpl() { sem_init(&semaphore, 0, 0); }
+    ~Pimpl() { sem_destroy(&semaphore); }
+
+    void post(int count)
+    {
+        for (int i = 0; i < count; ++i)
+            sem_post(&semaphore);
+    }
+
+    void wait()
+    {
+        //a signal handler can cut the wait short, that isn't a post
+        while (sem_wait(&semaphore) != 0 && errno == EINTR) {}
+    }
+
+    sem_t semaphore;
+};
+#endif
+
+Semaphore::Semaphore() : pimpl(std::make_unique<Pimpl>()) {}
+Semaphore::~Semaphore() = default;
+
+void Semaphore::post(int count)
+{
+    if (count > 0)
+        pimpl->post(count);
+}
+
+void Semaphore::wait()
+{
+    pimpl->wait();
+}
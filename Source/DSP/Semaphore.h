@@ -0,0 +1,34 @@
+/*
+  ==============================================================================
+
+    Semaphore.h
+    Created: 19 Oct 2026 10:12:44am
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+ Counting semaphore on the platform's own primitive: a futex-backed sem_t on Linux, a dispatch
+ semaphore on macOS and a kernel semaphore on Windows. Unlike juce::WaitableEvent, post() takes
+ no mutex, so the audio thread can use it to wake threads that are parked in wait().
+ */
+struct Semaphore
+{
+    Semaphore();
+    ~Semaphore();
+
+    /** lets up to count waiting threads through, now or the next time they wait */
+    void post(int count = 1);
+
+    /** blocks until a post() is there to take */
+    void wait();
+private:
+    struct Pimpl;
+    std::unique_ptr<Pimpl> pimpl;
+
+    JUCE_DECLARE_NON_COPYABLE(Semaphore)
+};
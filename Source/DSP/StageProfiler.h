@@ -0,0 +1,255 @@
+/*
+  ==============================================================================
+
+    StageProfiler.h
+    Created: 17 Oct 2026 10:26:48pm
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+ How long each stage of processBlock takes, kept per instance so a session that starts dropping
+ out can be traced to the stage that spikes.
+
+ Timing is off until the overlay (or whoever wants numbers) enables it, and then a stage costs
+ two clock reads each time it runs. A stage that runs once per sub-block adds up over the host
+ block and goes into its histogram once, so the figures are per host block.
+
+ Every stage has a histogram of quarter-octave buckets (each octave split linearly in four, so
+ p99 is good to 25%) plus exact min/max/sum. Only one thread writes a stage during a block: the
+ audio thread, or the band worker that got that band. The editor reads everything with relaxed
+ loads and gets a slightly torn but never broken view. Reset is a request that the audio thread
+ carries out at the start of its next block, so the counters keep a single writer.
+ */
+struct StageProfiler
+{
+    enum Stage
+    {
+        UpdateState,
+        AnalyzerFifo,
+        InputGain,
+        SplitBands,
+        CompressBand, //one slot per band from here on
+        Mix = CompressBand + 8,
+        NumStages
+    };
+
+    static juce::String getStageName(int stage)
+    {
+        if (stage >= CompressBand && stage < Mix)
+            return "Compress band " + juce::String(stage - CompressBand + 1);
+
+        switch (stage)
+        {
+            case UpdateState: return "Update state";
+            case AnalyzerFifo: return "Analyzer tap";
+            case InputGain: return "Input gain";
+            case SplitBands: return "Split bands";
+            case Mix: return "Mix + output gain";
+            default: return {};
+        }
+    }
+
+    struct Summary
+    {
+        juce::uint64 count{ 0 };
+        double minNs{ 0 }, meanNs{ 0 }, p99Ns{ 0 }, maxNs{ 0 };
+    };
+
+    /** times the enclosing scope into one stage of the current block, does nothing with a null profiler */
+    struct ScopedStage
+    {
+        ScopedStage(StageProfiler* p, int s) : profiler(p), stage(s)
+        {
+            if (profiler != nullptr)
+                start = juce::Time::getHighResolutionTicks();
+        }
+
+        ~ScopedStage()
+        {
+            if (profiler != nullptr)
+                profiler->accumulate(stage, juce::Time::getHighResolutionTicks() - start);
+        }
+
+        StageProfiler* profiler;
+        int stage;
+        juce::int64 start{ 0 };
+    };
+
+    /** any thread, nothing is timed while it's off */
+    void setEnabled(bool shouldBeEnabled) { enabled.store(shouldBeEnabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    /**
+     audio thread, once per host block before any stage runs.
+     Returns the profiler to time this block's stages with, or nullptr while timing is off.
+     */
+    StageProfiler* beginBlock()
+    {
+        if (resetRequested.exchange(false, std::memory_order_acquire))
+            for (auto& histogram : histograms)
+                histogram.clear();
+
+        if (! isEnabled())
+            return nullptr;
+
+        blockTicks.fill(0);
+        stageRan.fill(false);
+        return this;
+    }
+
+    /** audio thread, after a block beginBlock returned non-null for: each stage that ran adds its total */
+    void endBlock()
+    {
+        for (int stage = 0; stage < NumStages; ++stage)
+            if (stageRan[static_cast<size_t>(stage)])
+                add(stage, blockTicks[static_cast<size_t>(stage)]);
+    }
+
+    /** any thread, the counters clear at the start of the next block */
+    void requestReset() { resetRequested.store(true, std::memory_order_release); }
+
+    Summary getSummary(int stage) const
+    {
+        const auto& histogram = histograms[static_cast<size_t>(stage)];
+
+        Summary summary;
+        summary.count = histogram.count.load(std::memory_order_relaxed);
+        if (summary.count == 0)
+            return summary;
+
+        summary.minNs = ticksToNs(histogram.minTicks.load(std::memory_order_relaxed));
+        summary.maxNs = ticksToNs(histogram.maxTicks.load(std::memory_order_relaxed));
+        summary.meanNs = ticksToNs(histogram.sumTicks.load(std::memory_order_relaxed)) / static_cast<double>(summary.count);
+
+        //upper edge of the bucket the 99th percentile falls in, clipped to the real max
+        const auto target = static_cast<juce::uint64>(std::ceil(0.99 * static_cast<double>(summary.count)));
+        juce::uint64 seen = 0;
+
+        for (int bucket = 0; bucket < NumBuckets; ++bucket)
+        {
+            seen += histogram.buckets[static_cast<size_t>(bucket)].load(std::memory_order_relaxed);
+            if (seen >= target)
+            {
+                summary.p99Ns = juce::jmin(summary.maxNs, getBucketUpperEdgeNs(bucket));
+                break;
+            }
+        }
+
+        return summary;
+    }
+
+    /** one line per stage that has run, for pasting into a bug report */
+    juce::String toText() const
+    {
+        juce::String text;
+        text << "stage                     count       min ns      mean ns       p99 ns       max ns\n";
+
+        for (int stage = 0; stage < NumStages; ++stage)
+        {
+            auto summary = getSummary(stage);
+            if (summary.count == 0)
+                continue;
+
+            text << getStageName(stage).paddedRight(' ', 20)
+                 << juce::String(static_cast<juce::int64>(summary.count)).paddedLeft(' ', 11)
+                 << juce::String(summary.minNs, 0).paddedLeft(' ', 13)
+                 << juce::String(summary.meanNs, 0).paddedLeft(' ', 13)
+                 << juce::String(summary.p99Ns, 0).paddedLeft(' ', 13)
+                 << juce::String(summary.maxNs, 0).paddedLeft(' ', 13) << "\n";
+        }
+
+        return text;
+    }
+
+    bool dumpToFile(const juce::File& file) const
+    {
+        return file.replaceWithText(toText());
+    }
+private:
+    static constexpr int BucketsPerOctave = 4;
+    static constexpr int NumBuckets = 30 * BucketsPerOctave; //1ns to ~1s
+
+    struct Histogram
+    {
+        std::array<std::atomic<juce::uint32>, NumBuckets> buckets{};
+        std::atomic<juce::uint64> count{ 0 }, sumTicks{ 0 };
+        std::atomic<juce::int64> minTicks{ std::numeric_limits<juce::int64>::max() }, maxTicks{ 0 };
+
+        void clear()
+        {
+            for (auto& bucket : buckets)
+                bucket.store(0, std::memory_order_relaxed);
+
+            count.store(0, std::memory_order_relaxed);
+            sumTicks.store(0, std::memory_order_relaxed);
+            minTicks.store(std::numeric_limits<juce::int64>::max(), std::memory_order_relaxed);
+            maxTicks.store(0, std::memory_order_relaxed);
+        }
+    };
+
+    std::array<Histogram, NumStages> histograms;
+    std::atomic<bool> resetRequested{ false }, enabled{ false };
+
+    //the block in progress, same single writer per stage as the histograms
+    std::array<juce::int64, NumStages> blockTicks{};
+    std::array<bool, NumStages> stageRan{};
+
+    const double nsPerTick = 1.0e9 / static_cast<double>(juce::Time::getHighResolutionTicksPerSecond());
+
+    double ticksToNs(juce::int64 ticks) const { return static_cast<double>(ticks) * nsPerTick; }
+    double ticksToNs(juce::uint64 ticks) const { return static_cast<double>(ticks) * nsPerTick; }
+
+    /** octave from the top set bit, quarter from the two bits below it. Under 4ns is one bucket per ns. */
+    static int getBucket(juce::uint32 ns)
+    {
+        if (ns < 4)
+            return static_cast<int>(ns);
+
+        const auto octave = juce::findHighestSetBit(ns);
+        const auto quarter = static_cast<int>((ns >> (octave - 2)) & 3);
+        return juce::jmin(NumBuckets - 1, octave * BucketsPerOctave + quarter);
+    }
+
+    static double getBucketUpperEdgeNs(int bucket)
+    {
+        if (bucket < 4)
+            return static_cast<double>(bucket + 1);
+
+        const auto octave = bucket / BucketsPerOctave;
+        const auto quarter = bucket % BucketsPerOctave;
+        return std::ldexp(static_cast<double>(BucketsPerOctave + quarter + 1), octave - 2);
+    }
+
+    void accumulate(int stage, juce::int64 ticks)
+    {
+        blockTicks[static_cast<size_t>(stage)] += ticks;
+        stageRan[static_cast<size_t>(stage)] = true;
+    }
+
+    void add(int stage, juce::int64 ticks)
+    {
+        auto& histogram = histograms[static_cast<size_t>(stage)];
+
+        //anything past ~4s lands in the last bucket anyway
+        const auto ns = static_cast<juce::uint32>(juce::jlimit(0.0, 4.0e9, ticksToNs(ticks)));
+        const auto bucket = getBucket(ns);
+
+        //single writer per stage, so plain load/store instead of read-modify-write
+        auto& slot = histogram.buckets[static_cast<size_t>(bucket)];
+        slot.store(slot.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+        histogram.count.store(histogram.count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        histogram.sumTicks.store(histogram.sumTicks.load(std::memory_order_relaxed) + static_cast<juce::uint64>(ticks), std::memory_order_relaxed);
+
+        if (ticks < histogram.minTicks.load(std::memory_order_relaxed))
+            histogram.minTicks.store(ticks, std::memory_order_relaxed);
+
+        if (ticks > histogram.maxTicks.load(std::memory_order_relaxed))
+            histogram.maxTicks.store(ticks, std::memory_order_relaxed);
+    }
+};
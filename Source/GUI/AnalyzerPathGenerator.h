@@ -10,6 +10,7 @@
 
 #pragma once
 #include <JuceHeader.h>
+#include "../DSP/Fifo.h"
 
 template<typename PathType>
 struct AnalyzerPathGenerator
@@ -29,7 +30,13 @@ struct AnalyzerPathGenerator
 
         int numBins = (int)fftSize / 2;
 
-        PathType p;
+        //built straight into the slot, whose storage is still there from the last path through it
+        auto* slot = pathFifo.beginWrite();
+        if (slot == nullptr)
+            return;
+
+        auto& p = *slot;
+        p.clear();
         p.preallocateSpace(3 * (int)fftBounds.getWidth());
 
         auto map = [bottom, top, negativeInfinity](float v)
@@ -64,7 +71,7 @@ struct AnalyzerPathGenerator
             }
         }
 
-        pathFifo.push(p);
+        pathFifo.finishWrite();
     }
 
     int getNumPathsAvailable() const
@@ -72,10 +79,11 @@ struct AnalyzerPathGenerator
         return pathFifo.getNumAvailableForReading();
     }
 
+    /** swaps the oldest path into 'path', the slot keeps the old one's storage for reuse */
     bool getPath(PathType& path)
     {
-        return pathFifo.pull(path);
+        return pathFifo.read([&path](PathType& newest) { std::swap(path, newest); });
     }
 private:
-    Fifo<PathType> pathFifo;
+    Fifo<PathType> pathFifo{ FullPolicy::OverwriteOldest };
 };
\ No newline at end of file
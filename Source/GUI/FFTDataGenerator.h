@@ -21,6 +21,12 @@ struct FFTDataGenerator
      */
     void produceFFTDataForRendering(const juce::AudioBuffer<float>& audioData, const float negativeInfinity)
     {
+        //rendered in place, in the slot the path generator will read
+        auto* slot = fftDataFifo.beginWrite();
+        if (slot == nullptr)
+            return;
+
+        auto& fftData = *slot;
         const auto fftSize = getFFTSize();
 
         fftData.assign(fftData.size(), 0);
@@ -57,7 +63,7 @@ struct FFTDataGenerator
             fftData[i] = juce::Decibels::gainToDecibels(fftData[i], negativeInfinity);
         }
 
-        fftDataFifo.push(fftData);
+        fftDataFifo.finishWrite();
     }
 
     void changeOrder(FFTOrder newOrder)
@@ -72,21 +78,24 @@ struct FFTDataGenerator
         forwardFFT = std::make_unique<juce::dsp::FFT>(order);
         window = std::make_unique<juce::dsp::WindowingFunction<float>>(fftSize, juce::dsp::WindowingFunction<float>::blackmanHarris);
 
-        fftData.clear();
-        fftData.resize(fftSize * 2, 0);
-
-        fftDataFifo.prepare(fftData.size());
+        fftDataFifo.prepare([fftSize](BlockType& fftData)
+        {
+            fftData.clear();
+            fftData.resize(fftSize * 2, 0);
+        });
     }
     //==============================================================================
     int getFFTSize() const { return 1 << order; }
     int getNumAvailableFFTDataBlocks() const { return fftDataFifo.getNumAvailableForReading(); }
     //==============================================================================
-    bool getFFTData(BlockType& fftData) { return fftDataFifo.pull(fftData); }
+    /** use(const BlockType&) on the oldest rendered block, in place. False if there was none. */
+    template <typename Fn>
+    bool readFFTData(Fn&& use) { return fftDataFifo.read([&use](const BlockType& fftData) { use(fftData); }); }
 private:
     FFTOrder order;
-    BlockType fftData;
     std::unique_ptr<juce::dsp::FFT> forwardFFT;
     std::unique_ptr<juce::dsp::WindowingFunction<float>> window;
 
-    Fifo<BlockType> fftDataFifo;
+    //only the newest spectrum gets drawn anyway
+    Fifo<BlockType> fftDataFifo{ FullPolicy::OverwriteOldest };
 };
\ No newline at end of file
@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    GainReductionHistory.h
+    Created: 18 Oct 2026 12:40:16am
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../DSP/GainReductionStream.h"
+
+/*
+ The last couple of seconds of one band's gain reduction, for drawing.
+ Each point min-holds ValuesPerPoint values from the stream, so peaks survive the squeeze
+ down to screen resolution.
+ */
+struct GainReductionHistory
+{
+    static constexpr int NumPoints = 256;
+    static constexpr int ValuesPerPoint = 12; //~2s on screen at 48kHz
+
+    /** pulls everything the band published since the last frame */
+    void drain(GainReductionStream& stream)
+    {
+        std::array<float, 512> incoming;
+
+        for (auto numPulled = stream.pull(incoming.data(), static_cast<int>(incoming.size()));
+             numPulled > 0;
+             numPulled = stream.pull(incoming.data(), static_cast<int>(incoming.size())))
+        {
+            for (int i = 0; i < numPulled; ++i)
+            {
+                pendingGain = juce::jmin(pendingGain, incoming[static_cast<size_t>(i)]);
+
+                if (++pendingValues == ValuesPerPoint)
+                {
+                    points[static_cast<size_t>(nextPoint)] = juce::Decibels::gainToDecibels(pendingGain);
+                    nextPoint = (nextPoint + 1) % NumPoints;
+
+                    pendingGain = 1.f;
+                    pendingValues = 0;
+                }
+            }
+        }
+    }
+
+    /** 0 is the oldest point, NumPoints - 1 the newest */
+    float getPointDb(int index) const
+    {
+        return points[static_cast<size_t>((nextPoint + index) % NumPoints)];
+    }
+private:
+    std::array<float, NumPoints> points{};
+    int nextPoint{ 0 };
+
+    float pendingGain{ 1.f };
+    int pendingValues{ 0 };
+};
@@ -12,46 +12,33 @@
 
 void PathProducer::process(juce::Rectangle<float> fftBounds, double sampleRate)
 {
-    juce::AudioBuffer<float> tempIncomingBuffer;
-    while (leftChannelFifo->getNumCompleteBuffersAvailable() > 0)
-    {
-        if (leftChannelFifo->getAudioBuffer(tempIncomingBuffer))
-        {
-            auto size = tempIncomingBuffer.getNumSamples();
-
-            jassert(size <= monoBuffer.getNumSamples());
-            size = juce::jmin(size, monoBuffer.getNumSamples());
+    const auto fftSize = leftChannelFFTDataGenerator.getFFTSize();
+    const auto hopSize = fftSize / 4;
 
-            auto writePointer = monoBuffer.getWritePointer(0, 0);
-            auto readPointer = monoBuffer.getReadPointer(0, size);
-            std::copy(readPointer, readPointer + (monoBuffer.getNumSamples() - size), writePointer);
+    //after a stall only the last window is worth analysing, not every hop of the backlog
+    tap->skip(channel, tap->getNumReady(channel) - fftSize);
 
-            /*juce::FloatVectorOperations::copy(monoBuffer.getWritePointer(0, 0),
-                monoBuffer.getReadPointer(0, size),
-                monoBuffer.getNumSamples() - size);*/
+    while (tap->getNumReady(channel) >= hopSize)
+    {
+        //shift monoBuffer along by a hop and pull the new samples straight into its tail
+        auto writePointer = monoBuffer.getWritePointer(0, 0);
+        auto readPointer = monoBuffer.getReadPointer(0, hopSize);
+        std::copy(readPointer, readPointer + (fftSize - hopSize), writePointer);
 
-            juce::FloatVectorOperations::copy(monoBuffer.getWritePointer(0, monoBuffer.getNumSamples() - size),
-                tempIncomingBuffer.getReadPointer(0, 0),
-                size);
+        tap->pull(channel, monoBuffer.getWritePointer(0, fftSize - hopSize), hopSize);
 
-            leftChannelFFTDataGenerator.produceFFTDataForRendering(monoBuffer, negInfinity);
-        }
+        leftChannelFFTDataGenerator.produceFFTDataForRendering(monoBuffer, negInfinity);
     }
 
-    const auto fftSize = leftChannelFFTDataGenerator.getFFTSize();
     const auto binWidth = sampleRate / double(fftSize);
 
-    while (leftChannelFFTDataGenerator.getNumAvailableFFTDataBlocks() > 0)
+    auto generatePath = [&](const std::vector<float>& fftData)
     {
-        std::vector<float> fftData;
-        if (leftChannelFFTDataGenerator.getFFTData(fftData))
-        {
-            pathProducer.generatePath(fftData, fftBounds, fftSize, binWidth, negInfinity);
-        }
-    }
+        pathProducer.generatePath(fftData, fftBounds, fftSize, binWidth, negInfinity);
+    };
 
-    while (pathProducer.getNumPathsAvailable() > 0)
-    {
-        pathProducer.getPath(leftChannelFFTPath);
-    }
+    while (leftChannelFFTDataGenerator.readFFTData(generatePath)) {}
+
+    //only the newest path is kept, the rest just trade storage with it
+    while (pathProducer.getPath(leftChannelFFTPath)) {}
 }
\ No newline at end of file
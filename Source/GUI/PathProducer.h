@@ -16,18 +16,23 @@
 
 struct PathProducer
 {
-    PathProducer(SingleChannelSampleFifo<SimpleMBCompAudioProcessor::BlockType>& scsf) :
-        leftChannelFifo(&scsf)
+    PathProducer(AnalyzerTap& analyzerTap, Channel channelToUse) :
+        tap(&analyzerTap),
+        channel(channelToUse)
     {
         leftChannelFFTDataGenerator.changeOrder(FFTOrder::order2048);
         monoBuffer.setSize(1, leftChannelFFTDataGenerator.getFFTSize());
+
+        //whatever piled up while the editor was closed is stale
+        tap->skip(channel, tap->getNumReady(channel));
     }
     void process(juce::Rectangle<float> fftBounds, double sampleRate);
-    juce::Path getPath() { return leftChannelFFTPath; }
+    const juce::Path& getPath() const { return leftChannelFFTPath; }
     
     void updateNegInfinity(float nf) { negInfinity = nf; }
 private:
-    SingleChannelSampleFifo<SimpleMBCompAudioProcessor::BlockType>* leftChannelFifo;
+    AnalyzerTap* tap;
+    Channel channel;
 
     juce::AudioBuffer<float> monoBuffer;
 
@@ -0,0 +1,166 @@
+/*
+  ==============================================================================
+
+    ProfilerOverlay.cpp
+    Created: 17 Oct 2026 10:48:31pm
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#include "ProfilerOverlay.h"
+
+ProfilerOverlay::ProfilerOverlay(StageProfiler& p, DeadlineMonitor& m) : profiler(p), monitor(m)
+{
+    resetButton.onClick = [this]() { profiler.requestReset(); };
+    saveButton.onClick = [this]() { saveToFile(); };
+    clearMissesButton.onClick = [this]() { monitor.reset(); };
+    saveMissesWithStateButton.onClick = [this]() { monitor.setSavedWithState(saveMissesWithStateButton.getToggleState()); };
+
+    //percent of the block's real-time budget
+    thresholdSlider.setRange(5, 200, 5);
+    thresholdSlider.setTextValueSuffix("% budget");
+    thresholdSlider.setTextBoxStyle(juce::Slider::TextBoxRight, false, 90, 20);
+    thresholdSlider.onValueChange = [this]() { monitor.setThreshold(static_cast<float>(thresholdSlider.getValue() / 100.0)); };
+
+    addAndMakeVisible(resetButton);
+    addAndMakeVisible(saveButton);
+    addAndMakeVisible(clearMissesButton);
+    addAndMakeVisible(thresholdSlider);
+    addAndMakeVisible(saveMissesWithStateButton);
+
+    setInterceptsMouseClicks(true, true);
+}
+
+void ProfilerOverlay::paint(juce::Graphics& g)
+{
+    using namespace juce;
+
+    g.fillAll(Colours::black.withAlpha(0.85f));
+
+    auto bounds = getLocalBounds().reduced(8);
+    bounds.removeFromTop(24); //buttons
+
+    g.setFont(Font(Font::getDefaultMonospacedFontName(), 12.f, Font::plain));
+    const auto rowHeight = 15;
+
+    auto drawRow = [&](const String& name, const std::array<String, 5>& cells, Colour colour)
+    {
+        auto row = bounds.removeFromTop(rowHeight);
+        g.setColour(colour);
+        g.drawFittedText(name, row.removeFromLeft(130), Justification::centredLeft, 1);
+
+        const auto cellWidth = row.getWidth() / static_cast<int>(cells.size());
+        for (const auto& cell : cells)
+            g.drawFittedText(cell, row.removeFromLeft(cellWidth), Justification::centredRight, 1);
+    };
+
+    drawRow("stage", { "count", "min us", "mean us", "p99 us", "max us" }, Colours::grey);
+
+    auto micros = [](double ns) { return String(ns / 1000.0, 1); };
+
+    for (int stage = 0; stage < StageProfiler::NumStages; ++stage)
+    {
+        const auto& summary = summaries[static_cast<size_t>(stage)];
+        if (summary.count == 0)
+            continue;
+
+        drawRow(StageProfiler::getStageName(stage),
+                { String(static_cast<int64>(summary.count)), micros(summary.minNs), micros(summary.meanNs),
+                  micros(summary.p99Ns), micros(summary.maxNs) },
+                Colours::white);
+    }
+
+    //the session toggle, threshold slider and clear button sit along the bottom
+    bounds.removeFromBottom(24);
+    bounds.removeFromTop(rowHeight);
+
+    g.setColour(numMisses > 0 ? Colours::orange : Colours::grey);
+    g.drawFittedText(String(numMisses) + " of " + String(numBlocks) + " blocks over "
+                     + String(monitor.getThreshold() * 100.f, 0) + "% of their budget",
+                     bounds.removeFromTop(rowHeight), Justification::centredLeft, 1);
+
+    //newest first, as many as fit
+    for (auto it = misses.rbegin(); it != misses.rend() && bounds.getHeight() >= rowHeight; ++it)
+    {
+        auto text = Time(it->timeMs).toString(false, true, true, true)
+                  + "  block " + String(it->blockIndex)
+                  + "  " + String(it->numSamples) + " x " + String(it->numChannels) + " @ " + String(it->sampleRate, 0) + " Hz"
+                  + "  used " + String(it->usedFraction * 100.f, 0) + "%";
+
+        g.setColour(Colours::white);
+        g.drawFittedText(text, bounds.removeFromTop(rowHeight), Justification::centredLeft, 1);
+    }
+}
+
+void ProfilerOverlay::resized()
+{
+    auto bounds = getLocalBounds().reduced(8).removeFromTop(20);
+    saveButton.setBounds(bounds.removeFromRight(70));
+    bounds.removeFromRight(4);
+    resetButton.setBounds(bounds.removeFromRight(70));
+
+    auto bottom = getLocalBounds().reduced(8).removeFromBottom(20);
+    clearMissesButton.setBounds(bottom.removeFromRight(90));
+    bottom.removeFromRight(4);
+    thresholdSlider.setBounds(bottom.removeFromRight(220));
+    saveMissesWithStateButton.setBounds(bottom.removeFromLeft(180));
+}
+
+ProfilerOverlay::~ProfilerOverlay()
+{
+    profiler.setEnabled(false);
+}
+
+void ProfilerOverlay::visibilityChanged()
+{
+    //nobody looks at the timings while the overlay is hidden, so don't take them
+    profiler.setEnabled(isVisible());
+
+    if (isVisible())
+    {
+        timerCallback();
+        startTimerHz(4);
+    }
+    else
+    {
+        stopTimer();
+    }
+}
+
+void ProfilerOverlay::timerCallback()
+{
+    for (int stage = 0; stage < StageProfiler::NumStages; ++stage)
+        summaries[static_cast<size_t>(stage)] = profiler.getSummary(stage);
+
+    numBlocks = monitor.getNumBlocks();
+    numMisses = monitor.getNumMisses();
+    misses = monitor.getEvents();
+
+    //a state load can change these underneath the controls
+    if (! thresholdSlider.isMouseButtonDown())
+        thresholdSlider.setValue(monitor.getThreshold() * 100.0, juce::dontSendNotification);
+
+    saveMissesWithStateButton.setToggleState(monitor.isSavedWithState(), juce::dontSendNotification);
+
+    repaint();
+}
+
+void ProfilerOverlay::saveToFile()
+{
+    auto defaultFile = juce::File::getSpecialLocation(juce::File::userDesktopDirectory).getChildFile("SimpleMBComp profile.txt");
+    chooser = std::make_unique<juce::FileChooser>("Save stage timings", defaultFile, "*.txt");
+
+    auto flags = juce::FileBrowserComponent::saveMode
+               | juce::FileBrowserComponent::canSelectFiles
+               | juce::FileBrowserComponent::warnAboutOverwriting;
+
+    chooser->launchAsync(flags, [this](const juce::FileChooser& fc)
+    {
+        auto file = fc.getResult();
+        if (file != juce::File() && ! profiler.dumpToFile(file))
+            juce::AlertWindow::showMessageBoxAsync(juce::MessageBoxIconType::WarningIcon,
+                                                   "Save stage timings",
+                                                   "Couldn't write " + file.getFullPathName());
+    });
+}
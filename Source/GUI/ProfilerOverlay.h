@@ -0,0 +1,46 @@
+/*
+  ==============================================================================
+
+    ProfilerOverlay.h
+    Created: 17 Oct 2026 10:48:31pm
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../DSP/StageProfiler.h"
+#include "../DSP/DeadlineMonitor.h"
+
+/*
+ Table of the processor's stage timings drawn over the editor, followed by the blocks that went
+ over the deadline threshold. Hidden until the editor toggles it (Ctrl/Cmd+Shift+P), and the
+ processor only times its stages while it's showing.
+ */
+struct ProfilerOverlay : juce::Component, juce::Timer
+{
+    ProfilerOverlay(StageProfiler& p, DeadlineMonitor& m);
+    ~ProfilerOverlay() override;
+
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+    void visibilityChanged() override;
+    void timerCallback() override;
+
+private:
+    StageProfiler& profiler;
+    DeadlineMonitor& monitor;
+
+    juce::TextButton resetButton{ "Reset" }, saveButton{ "Save..." }, clearMissesButton{ "Clear misses" };
+    juce::ToggleButton saveMissesWithStateButton{ "Save misses with session" };
+    juce::Slider thresholdSlider{ juce::Slider::LinearHorizontal, juce::Slider::TextBoxRight };
+    std::unique_ptr<juce::FileChooser> chooser;
+
+    std::array<StageProfiler::Summary, StageProfiler::NumStages> summaries{};
+
+    juce::int64 numBlocks{ 0 }, numMisses{ 0 };
+    std::vector<DeadlineMonitor::Event> misses;
+
+    void saveToFile();
+};
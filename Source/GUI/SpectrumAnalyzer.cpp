@@ -15,8 +15,8 @@
 
 SpectrumAnalyzer::SpectrumAnalyzer(SimpleMBCompAudioProcessor& p) :
     audioProcessor(p),
-    leftPathProducer(audioProcessor.leftChannelFifo),
-    rightPathProducer(audioProcessor.rightChannelFifo)
+    leftPathProducer(audioProcessor.analyzerTap, Channel::Left),
+    rightPathProducer(audioProcessor.analyzerTap, Channel::Right)
 {
     const auto& params = audioProcessor.getParameters();
     for (auto param : params)
@@ -39,6 +39,10 @@ SpectrumAnalyzer::SpectrumAnalyzer(SimpleMBCompAudioProcessor& p) :
     floatHelper(midThreshParam, names::Threshold_Mid_Band);
     floatHelper(highThreshParam, names::Threshold_High_Band);
 
+    //whatever piled up while the editor was closed is stale
+    for (size_t band = 0; band < Params::NumBands; ++band)
+        audioProcessor.getGainReductionStream(band).discardPending();
+
     startTimerHz(60);
 }
 
@@ -60,17 +64,14 @@ void SpectrumAnalyzer::drawFFTAnalysis(juce::Graphics& g, juce::Rectangle<int> b
     Graphics::ScopedSaveState sss(g);
     g.reduceClipRegion(responseArea);
 
-    auto leftChannelFFTPath = leftPathProducer.getPath();
-    leftChannelFFTPath.applyTransform(AffineTransform().translation(responseArea.getX(), 0));
+    //stroked through a transform, so the paths are drawn where they are rather than copied and moved
+    const auto translation = AffineTransform().translation(responseArea.getX(), 0);
 
     g.setColour(Colour(186u, 34u, 34u)); //Colors for left and right of spectrum response
-    g.strokePath(leftChannelFFTPath, PathStrokeType(1.f));
-
-    auto rightChannelFFTPath = rightPathProducer.getPath();
-    rightChannelFFTPath.applyTransform(AffineTransform().translation(responseArea.getX(), 0));
+    g.strokePath(leftPathProducer.getPath(), PathStrokeType(1.f), translation);
 
     g.setColour(Colour(64u, 194u, 230u));
-    g.strokePath(rightChannelFFTPath, PathStrokeType(1.f));
+    g.strokePath(rightPathProducer.getPath(), PathStrokeType(1.f), translation);
 }
 
 void SpectrumAnalyzer::paint(juce::Graphics& g)
@@ -126,11 +127,35 @@ void SpectrumAnalyzer::drawCrossovers(juce::Graphics& g, juce::Rectangle <int> b
     };
 
     auto zeroDb = mapY(0.f);
+
+    //history runs oldest to newest across the band, newest at its right edge
+    auto drawHistory = [&](const GainReductionHistory& history, float x0, float x1)
+    {
+        Path path;
+        path.startNewSubPath(x0, zeroDb);
+
+        for (int i = 0; i < GainReductionHistory::NumPoints; ++i)
+        {
+            auto x = jmap(static_cast<float>(i), 0.f, static_cast<float>(GainReductionHistory::NumPoints - 1), x0, x1);
+            path.lineTo(x, mapY(jmax(NEGATIVE_INFINITY, history.getPointDb(i))));
+        }
+
+        path.lineTo(x1, zeroDb);
+        path.closeSubPath();
+
+        g.fillPath(path);
+    };
+
     g.setColour(Colour(186u, 34u, 34u).withAlpha(0.5f));
+    drawHistory(grHistories[0], left, lowMidX);
+    drawHistory(grHistories[1], lowMidX, midHighX);
+    drawHistory(grHistories[2], midHighX, right);
 
-    g.fillRect(Rectangle<float>::leftTopRightBottom(left, zeroDb, lowMidX, mapY(lowBandGR)));
-    g.fillRect(Rectangle<float>::leftTopRightBottom(lowMidX, zeroDb, midHighX, mapY(midBandGR)));
-    g.fillRect(Rectangle<float>::leftTopRightBottom(midHighX, zeroDb, right, mapY(highBandGR)));
+    //the RMS difference, a steadier read of the same thing
+    g.setColour(Colour(186u, 34u, 34u));
+    g.drawHorizontalLine(mapY(lowBandGR), left, lowMidX);
+    g.drawHorizontalLine(mapY(midBandGR), lowMidX, midHighX);
+    g.drawHorizontalLine(mapY(highBandGR), midHighX, right);
 
     g.setColour(Colours::white);
     g.drawHorizontalLine(mapY(lowTheshParam->get()), left, lowMidX);
@@ -354,5 +379,8 @@ void SpectrumAnalyzer::timerCallback()
 
     }
 
+    for (size_t band = 0; band < Params::NumBands; ++band)
+        grHistories[band].drain(audioProcessor.getGainReductionStream(band));
+
     repaint();
 }
\ No newline at end of file
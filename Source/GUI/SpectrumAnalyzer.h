@@ -11,6 +11,7 @@
 #pragma once
 #include <JuceHeader.h>
 #include "PathProducer.h"
+#include "GainReductionHistory.h"
 
 struct SpectrumAnalyzer : juce::Component,
     juce::AudioProcessorParameter::Listener,
@@ -69,4 +70,7 @@ private:
     float lowBandGR{ 0.f };
     float midBandGR{ 0.f };
     float highBandGR{ 0.f };
+
+    //sample-accurate gain reduction, drawn scrolling across each band's range
+    std::array<GainReductionHistory, Params::NumBands> grHistories;
 };
\ No newline at end of file
@@ -56,6 +56,10 @@ SimpleMBCompAudioProcessorEditor::SimpleMBCompAudioProcessorEditor (SimpleMBComp
     addAndMakeVisible(analyzer);
     addAndMakeVisible(globalControls);
     addAndMakeVisible(bandControls);
+    addChildComponent(profilerOverlay);
+
+    //for the profiler shortcut
+    setWantsKeyboardFocus(true);
 
     setSize (600, 500);
 
@@ -89,6 +93,7 @@ void SimpleMBCompAudioProcessorEditor::resized()
     analyzer.setBounds(bounds.removeFromTop(225));
     globalControls.setBounds(bounds);
 
+    profilerOverlay.setBounds(getLocalBounds().withTrimmedTop(controlBar.getHeight()));
 
 }
 
@@ -96,12 +101,12 @@ void SimpleMBCompAudioProcessorEditor::timerCallback()
 {
     std::vector<float> values
     {
-        audioProcessor.lowBandComp.getRMSInputDb(),
-        audioProcessor.lowBandComp.getRMSOutputDb(),
-        audioProcessor.midBandComp.getRMSInputDb(),
-        audioProcessor.midBandComp.getRMSOutputDb(),
-        audioProcessor.highBandComp.getRMSInputDb(),
-        audioProcessor.highBandComp.getRMSOutputDb(),
+        audioProcessor.getRMSInputDb(0),
+        audioProcessor.getRMSOutputDb(0),
+        audioProcessor.getRMSInputDb(1),
+        audioProcessor.getRMSOutputDb(1),
+        audioProcessor.getRMSInputDb(2),
+        audioProcessor.getRMSOutputDb(2),
     };
 
     analyzer.update(values);
@@ -109,6 +114,18 @@ void SimpleMBCompAudioProcessorEditor::timerCallback()
     updateGlobalBypassButton();
 }
 
+bool SimpleMBCompAudioProcessorEditor::keyPressed(const juce::KeyPress& key)
+{
+    //Ctrl+Shift+P (Cmd+Shift+P on mac) shows the stage timings
+    if (key == juce::KeyPress('p', juce::ModifierKeys::commandModifier | juce::ModifierKeys::shiftModifier, 0))
+    {
+        profilerOverlay.setVisible(! profilerOverlay.isVisible());
+        return true;
+    }
+
+    return false;
+}
+
 void SimpleMBCompAudioProcessorEditor::updateGlobalBypassButton()
 {
     auto params = getBypassParams();
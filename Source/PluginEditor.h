@@ -17,6 +17,7 @@
 #include "GUI/UtilityComps.h"
 #include "GUI/SpectrumAnalyzer.h"
 #include "GUI/CustomButtons.h"
+#include "GUI/ProfilerOverlay.h"
 
 struct ControlBar : juce::Component
 {
@@ -42,6 +43,8 @@ public:
 
     void timerCallback() override;
 
+    bool keyPressed(const juce::KeyPress& key) override;
+
 private:
 
     LookAndFeel lnf;
@@ -54,6 +57,7 @@ private:
     CompressorBandControls bandControls{ audioProcessor.apvts };
     SpectrumAnalyzer analyzer {audioProcessor};
     ControlBar controlBar;
+    ProfilerOverlay profilerOverlay{ audioProcessor.profiler, audioProcessor.deadlineMonitor };
 
     void toggleGlobalBypassState();
 
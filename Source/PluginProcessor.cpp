@@ -8,7 +8,6 @@
 
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
-#include "DSP/Params.h"
 
 //==============================================================================
 SimpleMBCompAudioProcessor::SimpleMBCompAudioProcessor()
@@ -17,6 +16,7 @@ SimpleMBCompAudioProcessor::SimpleMBCompAudioProcessor()
                      #if ! JucePlugin_IsMidiEffect
                       #if ! JucePlugin_IsSynth
                        .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
+                       .withInput  ("Sidechain", juce::AudioChannelSet::stereo(), false)
                       #endif
                        .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
                      #endif
@@ -44,48 +44,45 @@ SimpleMBCompAudioProcessor::SimpleMBCompAudioProcessor()
         jassert(param != nullptr);
     };
 
-    //Low end compressor
-    floatHelper(lowBandComp.Attack, names::Attack_Low_Band);
-    floatHelper(lowBandComp.Release, names::Release_Low_Band);
-    floatHelper(lowBandComp.Threshold, names::Threshold_Low_Band);
-    choiceHelper(lowBandComp.Ratio, names::Ratio_Low_Band);
-    boolHelper(lowBandComp.Bypassed, names::Bypassed_Low_Band);
-    boolHelper(lowBandComp.Mute, names::Mute_Low_Band);
-    boolHelper(lowBandComp.Solo, names::Solo_Low_Band);
-
-    //mid compressor
-    floatHelper(midBandComp.Attack, names::Attack_Mid_Band);
-    floatHelper(midBandComp.Release, names::Release_Mid_Band);
-    floatHelper(midBandComp.Threshold, names::Threshold_Mid_Band);
-    choiceHelper(midBandComp.Ratio, names::Ratio_Mid_Band);
-    boolHelper(midBandComp.Bypassed, names::Bypassed_Mid_Band);
-    boolHelper(midBandComp.Mute, names::Mute_Mid_Band);
-    boolHelper(midBandComp.Solo, names::Solo_Mid_Band);
-
-    //high end compressor
-    floatHelper(highBandComp.Attack, names::Attack_High_Band);
-    floatHelper(highBandComp.Release, names::Release_High_Band);
-    floatHelper(highBandComp.Threshold, names::Threshold_High_Band);
-    choiceHelper(highBandComp.Ratio, names::Ratio_High_Band);
-    boolHelper(highBandComp.Bypassed, names::Bypassed_High_Band);
-    boolHelper(highBandComp.Mute, names::Mute_High_Band);
-    boolHelper(highBandComp.Solo, names::Solo_High_Band);
+    auto attachBand = [&](auto& comp, size_t band)
+    {
+        floatHelper(comp.Attack, getBandParam(names::Attack_Low_Band, band));
+        floatHelper(comp.Release, getBandParam(names::Release_Low_Band, band));
+        floatHelper(comp.Threshold, getBandParam(names::Threshold_Low_Band, band));
+        choiceHelper(comp.Ratio, getBandParam(names::Ratio_Low_Band, band));
+        boolHelper(comp.Bypassed, getBandParam(names::Bypassed_Low_Band, band));
+        boolHelper(comp.Mute, getBandParam(names::Mute_Low_Band, band));
+        boolHelper(comp.Solo, getBandParam(names::Solo_Low_Band, band));
+        choiceHelper(comp.Oversampling, getBandParam(names::Oversampling_Low_Band, band));
+        floatHelper(comp.Lookahead, getBandParam(names::Lookahead_Low_Band, band));
+        choiceHelper(comp.DetectorLink, names::Detector_Link);
+    };
+
+    for (size_t band = 0; band < Params::NumBands; ++band)
+    {
+        attachBand(floatCore.compressors[band], band);
+        attachBand(doubleCore.compressors[band], band);
+    }
+
+    //the miss record keeps a fixed-size copy of every parameter
+    jassert(getParameters().size() <= DeadlineMonitor::MaxParameters);
 
     //crossovers
-    floatHelper(lowMidCrossover, names::Low_Mid_Crossover_Freq);
-    floatHelper(midHighCrossover, names::Mid_High_Crossover_Freq);
+    for (size_t i = 0; i < crossoverFrequencies.size(); ++i)
+    {
+        floatHelper(crossoverFrequencies[i], getCrossoverParam(i));
+    }
 
     //in and out Gains
     floatHelper(inputGainParam, names::Gain_in);
     floatHelper(outputGainParam, names::Gain_out);
 
-    LP1.setType(juce::dsp::LinkwitzRileyFilterType::lowpass);
-    HP1.setType(juce::dsp::LinkwitzRileyFilterType::highpass);
-
-    AP2.setType(juce::dsp::LinkwitzRileyFilterType::allpass);
+    boolHelper(linearPhaseParam, names::Linear_Phase_Crossover);
+    boolHelper(sidechainParam, names::External_Sidechain);
+    boolHelper(parallelBandsParam, names::Parallel_Bands);
 
-    LP2.setType(juce::dsp::LinkwitzRileyFilterType::lowpass);
-    HP2.setType(juce::dsp::LinkwitzRileyFilterType::highpass);
+    //setLatencySamples can lock (the host's listeners), so changes found on the audio thread wait for this
+    startTimerHz(10);
 }
 
 SimpleMBCompAudioProcessor::~SimpleMBCompAudioProcessor()
@@ -127,7 +124,14 @@ bool SimpleMBCompAudioProcessor::isMidiEffect() const
 
 double SimpleMBCompAudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    auto sampleRate = getSampleRate();
+    auto tailSamples = isUsingDoublePrecision() ? doubleCore.getTailSamples() : floatCore.getTailSamples();
+    return sampleRate > 0 ? tailSamples / sampleRate : 0.0;
+}
+
+bool SimpleMBCompAudioProcessor::supportsDoublePrecisionProcessing() const
+{
+    return true;
 }
 
 int SimpleMBCompAudioProcessor::getNumPrograms()
@@ -165,37 +169,37 @@ void SimpleMBCompAudioProcessor::prepareToPlay(double sampleRate, int samplesPer
     spec.numChannels = getTotalNumOutputChannels();
     spec.sampleRate = sampleRate;
 
-    for (auto& comp : compressors)
-        comp.prepare(spec);
+    if (isUsingDoublePrecision())
+        prepareCore<double>(spec);
+    else
+        prepareCore<float>(spec);
 
-    LP1.prepare(spec);
-    HP1.prepare(spec);
-
-    AP2.prepare(spec);
+    osc.initialise([](float x) {return std::sin(x); });
+    osc.prepare(spec);
+    osc.setFrequency(500);
 
-    LP2.prepare(spec);
-    HP2.prepare(spec);
+    gain.prepare(spec);
+    gain.setGainDecibels(-12.f);
+}
 
-    inputGain.prepare(spec);
-    outputGain.prepare(spec);
+template <typename SampleType>
+void SimpleMBCompAudioProcessor::prepareCore(const juce::dsp::ProcessSpec& spec)
+{
+    auto& core = getCore<SampleType>();
 
-    inputGain.setRampDurationSeconds(.05);
-    outputGain.setRampDurationSeconds(.05);
+    //so the crossovers build their first coefficients/kernels from the real settings
+    updateState<SampleType>();
 
-    for (auto& buffer : filterBuffers) //Not really sure what this is, come back to it
-    {
-        buffer.setSize(spec.numChannels, samplesPerBlock);
-    }
+    core.prepare(spec);
 
-    leftChannelFifo.prepare(samplesPerBlock);
-    rightChannelFifo.prepare(samplesPerBlock);
+    //not on the audio thread here, the host gets told straight away
+    pendingLatencySamples.store(core.getLatencySamples());
+    setLatencySamples(core.getLatencySamples());
 
-    osc.initialise([](float x) {return std::sin(x); });
-    osc.prepare(spec);
-    osc.setFrequency(500);
+    core.setGainRampDurationSeconds(.05);
 
-    gain.prepare(spec);
-    gain.setGainDecibels(-12.f);
+    //VU-like 300ms RMS, peaks fall back at 12dB/s. Nothing draws true peak yet, so it isn't paid for
+    core.setMetering(300.f, 12.f, false);
 }
 
 void SimpleMBCompAudioProcessor::releaseResources()
@@ -211,18 +215,24 @@ bool SimpleMBCompAudioProcessor::isBusesLayoutSupported (const BusesLayout& layo
     juce::ignoreUnused (layouts);
     return true;
   #else
-    // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    // Some plugin hosts, such as certain GarageBand versions, will only
-    // load plugins that support stereo bus layouts.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    // Anything from mono up to 7.1.4 or third order ambisonics (16 channels),
+    // every channel goes through the crossovers and compressors.
+    auto numChannels = layouts.getMainOutputChannelSet().size();
+    if (numChannels < 1 || numChannels > CompressorKernel<float>::MaxChannels)
         return false;
 
     // This checks if the input layout matches the output layout
    #if ! JucePlugin_IsSynth
     if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
         return false;
+
+    // The sidechain is optional and gets summed to mono, any width the main bus takes will do.
+    if (layouts.inputBuses.size() > 1)
+    {
+        auto sidechainChannels = layouts.getChannelSet(true, 1).size();
+        if (sidechainChannels > CompressorKernel<float>::MaxChannels)
+            return false;
+    }
    #endif
 
     return true;
@@ -230,52 +240,81 @@ bool SimpleMBCompAudioProcessor::isBusesLayoutSupported (const BusesLayout& layo
 }
 #endif
 
-void SimpleMBCompAudioProcessor::updateState() 
+template <typename SampleType>
+void SimpleMBCompAudioProcessor::updateState()
 {
-    for (auto& compressor : compressors)
-        compressor.updateCompressorSettings();
+    auto& core = getCore<SampleType>();
+
+    core.updateCompressorSettings();
+
+    for (size_t i = 0; i < crossoverFrequencies.size(); ++i)
+        core.setCrossoverFrequency(i, crossoverFrequencies[i]->get());
 
-    auto lowMidCutoff = lowMidCrossover->get();
-    LP1.setCutoffFrequency(lowMidCutoff);
-    HP1.setCutoffFrequency(lowMidCutoff);
+    core.setInputGainDecibels(inputGainParam->get());
+    core.setOutputGainDecibels(outputGainParam->get());
 
-    auto midHighCutoff = midHighCrossover->get();
-    AP2.setCutoffFrequency(midHighCutoff);
-    LP2.setCutoffFrequency(midHighCutoff);
-    HP2.setCutoffFrequency(midHighCutoff);
+    core.setLinearPhase(linearPhaseParam->get());
+    core.setParallelBands(parallelBandsParam->get());
 
-    inputGain.setGainDecibels(inputGainParam->get());
-    outputGain.setGainDecibels(outputGainParam->get());
+    pendingLatencySamples.store(core.getLatencySamples(), std::memory_order_relaxed);
 }
 
-void SimpleMBCompAudioProcessor::splitBands(const juce::AudioBuffer<float>& inputBuffer)
+void SimpleMBCompAudioProcessor::timerCallback()
 {
-    for (auto& fb : filterBuffers)
-    {
-        fb = inputBuffer;
-    }
+    const auto latency = pendingLatencySamples.load(std::memory_order_relaxed);
+    if (latency != getLatencySamples())
+        setLatencySamples(latency);
+
+    //threads are started and stopped here rather than from the parameter change on the audio thread
+    const auto parallelBands = parallelBandsParam->get();
+    floatCore.updateWorkers(parallelBands && ! isUsingDoublePrecision());
+    doubleCore.updateWorkers(parallelBands && isUsingDoublePrecision());
+}
 
-    auto fb0Block = juce::dsp::AudioBlock<float>(filterBuffers[0]);
-    auto fb1Block = juce::dsp::AudioBlock<float>(filterBuffers[1]);
-    auto fb2Block = juce::dsp::AudioBlock<float>(filterBuffers[2]);
+float SimpleMBCompAudioProcessor::getRMSInputDb(size_t band) const
+{
+    return isUsingDoublePrecision() ? doubleCore.compressors[band].getRMSInputDb()
+                                    : floatCore.compressors[band].getRMSInputDb();
+}
 
-    auto fb0Ctx = juce::dsp::ProcessContextReplacing<float>(fb0Block);
-    auto fb1Ctx = juce::dsp::ProcessContextReplacing<float>(fb1Block);
-    auto fb2Ctx = juce::dsp::ProcessContextReplacing<float>(fb2Block);
+float SimpleMBCompAudioProcessor::getRMSOutputDb(size_t band) const
+{
+    return isUsingDoublePrecision() ? doubleCore.compressors[band].getRMSOutputDb()
+                                    : floatCore.compressors[band].getRMSOutputDb();
+}
+
+GainReductionStream& SimpleMBCompAudioProcessor::getGainReductionStream(size_t band)
+{
+    return isUsingDoublePrecision() ? doubleCore.compressors[band].getGainReductionStream()
+                                    : floatCore.compressors[band].getGainReductionStream();
+}
+
+void SimpleMBCompAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    if (false) //Spectrum analyzer testing
+    {
+        buffer.clear();
+        auto block = juce::dsp::AudioBlock<float>(buffer);
+        auto ctx = juce::dsp::ProcessContextReplacing<float>(block);
+        osc.process(ctx);
 
-    LP1.process(fb0Ctx);
-    AP2.process(fb0Ctx);
+        gain.process(ctx);
+    }
 
-    HP1.process(fb1Ctx);
-    filterBuffers[2] = filterBuffers[1];
-    LP2.process(fb1Ctx);
+    process(buffer);
+}
 
-    HP2.process(fb2Ctx);
+void SimpleMBCompAudioProcessor::processBlock(juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    process(buffer);
 }
 
-void SimpleMBCompAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+template <typename SampleType>
+void SimpleMBCompAudioProcessor::process(juce::AudioBuffer<SampleType>& buffer)
 {
     juce::ScopedNoDenormals noDenormals;
+    const auto blockStart = juce::Time::getHighResolutionTicks();
+
     auto totalNumInputChannels = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
 
@@ -288,78 +327,65 @@ void SimpleMBCompAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear(i, 0, buffer.getNumSamples());
 
-    updateState();
-
-    
-    if (false) //Spectrum analyzer testing
-    {
-        buffer.clear();
-        auto block = juce::dsp::AudioBlock<float>(buffer);
-        auto ctx = juce::dsp::ProcessContextReplacing<float>(block);
-        osc.process(ctx);
+    auto& core = getCore<SampleType>();
 
-        gain.process(ctx);
-    }
+    // nullptr unless the overlay is showing, and then every stage below is a null check
+    auto* blockProfiler = profiler.beginBlock();
+    core.setProfiler(blockProfiler);
 
-    leftChannelFifo.update(buffer);
-    rightChannelFifo.update(buffer);
+    // the host buffer carries the sidechain channels after the main ones
+    auto mainBuffer = getBusBuffer(buffer, true, 0);
 
-    applyGain(buffer, inputGain);
+    juce::AudioBuffer<SampleType> sidechainBuffer;
+    const juce::AudioBuffer<SampleType>* sidechain = nullptr;
 
-    splitBands(buffer);
-    
-    for (size_t i = 0; i < filterBuffers.size(); ++i)
+    if (sidechainParam->get() && getBusCount(true) > 1 && getChannelCountOfBus(true, 1) > 0)
     {
-        compressors[i].process(filterBuffers[i]);    }
-    
-    auto numSamples = buffer.getNumSamples();
-    auto numChannels = buffer.getNumChannels();
-
-    buffer.clear();
+        sidechainBuffer = getBusBuffer(buffer, true, 1);
+        sidechain = &sidechainBuffer;
+    }
 
-    auto addFilterBand = [nc = numChannels, ns = numSamples](auto& inputBuffer, const auto& source)
     {
-        for (auto i = 0; i < nc; i++)
-        {
-            inputBuffer.addFrom(i, 0, source, i, 0, ns);
-        };
-    };
+        StageProfiler::ScopedStage stage(blockProfiler, StageProfiler::AnalyzerFifo);
+        analyzerTap.push(mainBuffer);
+    }
+
+    const auto numSamples = mainBuffer.getNumSamples();
+    auto start = 0;
 
-    auto bandsAreSoloed = false;
-    for (auto& comp : compressors)
+    // however the host slices its blocks, the core gets fixed-size pieces that stay in cache,
+    // and parameter changes are picked up between them
+    do
     {
-        if (comp.Solo->get())
         {
-            bandsAreSoloed = true;
-            break;
+            StageProfiler::ScopedStage stage(blockProfiler, StageProfiler::UpdateState);
+            updateState<SampleType>();
         }
-    }
 
+        const auto subBlockSize = juce::jmin(core.getSubBlockSize(), numSamples - start);
 
-    if (bandsAreSoloed)
-    {
-        for (size_t i = 0; i < compressors.size(); i++) 
+        // these only point into the host buffer, nothing is copied or allocated
+        juce::AudioBuffer<SampleType> subBlock(mainBuffer.getArrayOfWritePointers(), mainBuffer.getNumChannels(), start, subBlockSize);
+
+        if (sidechain != nullptr)
         {
-            auto& comp = compressors[i];
-            if (comp.Solo->get())
-            {
-                addFilterBand(buffer, filterBuffers[i]);
-            }
+            juce::AudioBuffer<SampleType> subSidechain(sidechainBuffer.getArrayOfWritePointers(), sidechainBuffer.getNumChannels(), start, subBlockSize);
+            core.process(subBlock, &subSidechain);
         }
-    }
-    else 
-    {
-        for (size_t i = 0; i < compressors.size(); i++)
+        else
         {
-            auto& comp = compressors[i];
-            if (! comp.Mute->get())
-            {
-                addFilterBand(buffer, filterBuffers[i]);
-            }
+            core.process(subBlock);
         }
+
+        start += subBlockSize;
     }
+    while (start < numSamples);
 
-    applyGain(buffer, outputGain);
+    if (blockProfiler != nullptr)
+        blockProfiler->endBlock();
+
+    const auto elapsed = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - blockStart);
+    deadlineMonitor.addBlock(elapsed, mainBuffer.getNumSamples(), mainBuffer.getNumChannels(), getSampleRate(), getParameters());
 }
 
 
@@ -383,8 +409,14 @@ void SimpleMBCompAudioProcessor::getStateInformation (juce::MemoryBlock& destDat
     // You could do that either as raw data, or use the XML or ValueTree classes
     // as intermediaries to make it easy to save and load complex data.
 
+    auto state = apvts.copyState();
+
+    //diagnostics only when the overlay asked for them, they'd change with every playback otherwise
+    if (deadlineMonitor.isSavedWithState())
+        state.appendChild(deadlineMonitor.toValueTree(getParameters()), nullptr);
+
     juce::MemoryOutputStream mos(destData, true); 
-    apvts.state.writeToStream(mos);
+    state.writeToStream(mos);
 }
 
 void SimpleMBCompAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
@@ -394,6 +426,12 @@ void SimpleMBCompAudioProcessor::setStateInformation (const void* data, int size
 
     auto tree = juce::ValueTree::readFromData(data, sizeInBytes);
     if (tree.isValid()) {
+        //a session saved with its diagnostics keeps saving them
+        auto misses = tree.getChildWithName(DeadlineMonitor::StateType);
+        deadlineMonitor.setSavedWithState(misses.isValid());
+        deadlineMonitor.fromValueTree(misses);
+        tree.removeChild(misses, nullptr);
+
         apvts.replaceState(tree);
     }
 }
@@ -414,51 +452,71 @@ juce::AudioProcessorValueTreeState::ParameterLayout SimpleMBCompAudioProcessor::
     layout.add(std::make_unique<AudioParameterFloat>(params.at(names::Gain_in), params.at(names::Gain_in), gainRange, 0));
     layout.add(std::make_unique<AudioParameterFloat>(params.at(names::Gain_out), params.at(names::Gain_out), gainRange, 0));
 
-    //low end compressor parameters
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(names::Threshold_Low_Band), params.at(names::Threshold_Low_Band), thresholdRange, 0));
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(names::Attack_Low_Band), params.at(names::Attack_Low_Band), attackAndReleaseRange, 50));
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(names::Release_Low_Band), params.at(names::Release_Low_Band), attackAndReleaseRange, 250));
+    //per-band parameters come from the low band's name, so every band gets its own ID and name.
+    //The loops keep the order the parameters have always had, hosts may index them by it.
+    auto addBandFloats = [&](names lowBandParam, const NormalisableRange<float>& range, float defaultValue, size_t band)
+    {
+        const auto& name = params.at(getBandParam(lowBandParam, band));
+        layout.add(std::make_unique<AudioParameterFloat>(name, name, range, defaultValue));
+    };
 
-    //Mid compressor paramaters
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(names::Threshold_Mid_Band), params.at(names::Threshold_Mid_Band), thresholdRange, 0));
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(names::Attack_Mid_Band), params.at(names::Attack_Mid_Band), attackAndReleaseRange, 50));
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(names::Release_Mid_Band), params.at(names::Release_Mid_Band), attackAndReleaseRange, 250)); 
+    auto addBandBools = [&](names lowBandParam)
+    {
+        for (size_t band = 0; band < NumBands; ++band)
+        {
+            const auto& name = params.at(getBandParam(lowBandParam, band));
+            layout.add(std::make_unique<AudioParameterBool>(name, name, false));
+        }
+    };
 
-    //HIgh end compressor prameters
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(names::Threshold_High_Band), params.at(names::Threshold_High_Band), thresholdRange, 0));
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(names::Attack_High_Band), params.at(names::Attack_High_Band), attackAndReleaseRange, 50));
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(names::Release_High_Band), params.at(names::Release_High_Band), attackAndReleaseRange, 250));
+    //threshold, attack and release, band by band
+    for (size_t band = 0; band < NumBands; ++band)
+    {
+        addBandFloats(names::Threshold_Low_Band, thresholdRange, 0, band);
+        addBandFloats(names::Attack_Low_Band, attackAndReleaseRange, 50, band);
+        addBandFloats(names::Release_Low_Band, attackAndReleaseRange, 250, band);
+    }
 
-    auto ratioChoices = std::vector<double>{ 1, 1.5, 2, 3, 4, 5, 6, 7, 8, 9, 10, 20, 50, 100 };
     juce::StringArray sa;
-    for (auto choice : ratioChoices)
+    for (auto choice : Params::RatioChoices)
     {
         sa.add(juce::String(choice, 1));
     }
 
     //Ratio Parameters
-    layout.add(std::make_unique<AudioParameterChoice>(params.at(names::Ratio_Low_Band), params.at(names::Ratio_Low_Band), sa, 3));
-    layout.add(std::make_unique<AudioParameterChoice>(params.at(names::Ratio_Mid_Band), params.at(names::Ratio_Mid_Band), sa, 3));
-    layout.add(std::make_unique<AudioParameterChoice>(params.at(names::Ratio_High_Band), params.at(names::Ratio_High_Band), sa, 3));
-
-    //Bypass Parameters
-    layout.add(std::make_unique<AudioParameterBool>(params.at(names::Bypassed_Low_Band), params.at(names::Bypassed_Low_Band), false));
-    layout.add(std::make_unique<AudioParameterBool>(params.at(names::Bypassed_Mid_Band), params.at(names::Bypassed_Mid_Band), false));
-    layout.add(std::make_unique<AudioParameterBool>(params.at(names::Bypassed_High_Band), params.at(names::Bypassed_High_Band), false));
-
-    //Mute Parameters
-    layout.add(std::make_unique<AudioParameterBool>(params.at(names::Mute_Low_Band), params.at(names::Mute_Low_Band), false));
-    layout.add(std::make_unique<AudioParameterBool>(params.at(names::Mute_Mid_Band), params.at(names::Mute_Mid_Band), false));
-    layout.add(std::make_unique<AudioParameterBool>(params.at(names::Mute_High_Band), params.at(names::Mute_High_Band), false));
+    for (size_t band = 0; band < NumBands; ++band)
+    {
+        const auto& name = params.at(getBandParam(names::Ratio_Low_Band, band));
+        layout.add(std::make_unique<AudioParameterChoice>(name, name, sa, 3));
+    }
 
-    //Solo Parameters
-    layout.add(std::make_unique<AudioParameterBool>(params.at(names::Solo_Low_Band), params.at(names::Solo_Low_Band), false));
-    layout.add(std::make_unique<AudioParameterBool>(params.at(names::Solo_Mid_Band), params.at(names::Solo_Low_Band), false));
-    layout.add(std::make_unique<AudioParameterBool>(params.at(names::Solo_High_Band), params.at(names::Solo_Low_Band), false));
+    addBandBools(names::Bypassed_Low_Band);
+    addBandBools(names::Mute_Low_Band);
+    addBandBools(names::Solo_Low_Band);
 
     layout.add(std::make_unique<AudioParameterFloat>(params.at(names::Low_Mid_Crossover_Freq), params.at(names::Low_Mid_Crossover_Freq), NormalisableRange<float>(MIN_FREQUENCY, 999, 1, 1), 400));
 
     layout.add(std::make_unique<AudioParameterFloat>(params.at(names::Mid_High_Crossover_Freq), params.at(names::Mid_High_Crossover_Freq), NormalisableRange<float>(1000, MAX_FREQUENCY, 1, 1), 2000));
+
+    layout.add(std::make_unique<AudioParameterBool>(params.at(names::Linear_Phase_Crossover), params.at(names::Linear_Phase_Crossover), false));
+
+    //Oversampling Parameters
+    auto oversamplingChoices = juce::StringArray{ "1x", "2x", "4x", "8x" };
+    for (size_t band = 0; band < NumBands; ++band)
+    {
+        const auto& name = params.at(getBandParam(names::Oversampling_Low_Band, band));
+        layout.add(std::make_unique<AudioParameterChoice>(name, name, oversamplingChoices, 0));
+    }
+
+    //Lookahead Parameters
+    auto lookaheadRange = NormalisableRange<float>(0.f, CompressorBand<float>::MaxLookaheadMs, 0.1f, 1.f);
+    for (size_t band = 0; band < NumBands; ++band)
+        addBandFloats(names::Lookahead_Low_Band, lookaheadRange, 0, band);
+
+    layout.add(std::make_unique<AudioParameterChoice>(params.at(names::Detector_Link), params.at(names::Detector_Link), juce::StringArray{ "Off", "Pairs", "All" }, 0));
+
+    layout.add(std::make_unique<AudioParameterBool>(params.at(names::External_Sidechain), params.at(names::External_Sidechain), false));
+    layout.add(std::make_unique<AudioParameterBool>(params.at(names::Parallel_Bands), params.at(names::Parallel_Bands), false));
         
 
     return layout;
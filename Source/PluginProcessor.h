@@ -9,13 +9,16 @@
 #pragma once
 
 #include <JuceHeader.h>
-#include "DSP/CompressorBand.h"
-#include "DSP/SingleChannelSampleFifo.h"
+#include "DSP/MultibandCore.h"
+#include "DSP/DeadlineMonitor.h"
+#include "DSP/Params.h"
+#include "DSP/AnalyzerTap.h"
 
 //==============================================================================
 /**
 */
-class SimpleMBCompAudioProcessor  : public juce::AudioProcessor
+class SimpleMBCompAudioProcessor  : public juce::AudioProcessor,
+                                    private juce::Timer
                             #if JucePlugin_Enable_ARA
                              , public juce::AudioProcessorARAExtension
                             #endif
@@ -34,6 +37,8 @@ public:
    #endif
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override;
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -63,43 +68,58 @@ public:
 
     APVTS apvts{ *this, nullptr, "Parameters", createParameterLayout() };
 
-    using BlockType = juce::AudioBuffer<float>;
-    SingleChannelSampleFifo<BlockType> leftChannelFifo{ Channel::Left };
-    SingleChannelSampleFifo<BlockType> rightChannelFifo{ Channel::Right };
-    
-    std::array<CompressorBand, 3> compressors;
-    CompressorBand& lowBandComp = compressors[0];
-    CompressorBand& midBandComp = compressors[1];
-    CompressorBand& highBandComp = compressors[2];
+    /** both channels of the input, on their way to the spectrum analyzer */
+    AnalyzerTap analyzerTap;
 
-private:
-    using Filter = juce::dsp::LinkwitzRileyFilter<float>;
-    //     fc0  fc1
-    Filter LP1, AP2,
-           HP1, LP2,
-                HP2;
+    /** per-stage timings of processBlock, read by the editor's profiler overlay */
+    StageProfiler profiler;
+
+    /** blocks that took too much of their real-time budget, saved with the state */
+    DeadlineMonitor deadlineMonitor;
+    
+    //one per precision, only the one the host asked for gets prepared
+    MultibandCore<float, Params::NumBands> floatCore;
+    MultibandCore<double, Params::NumBands> doubleCore;
 
-    juce::AudioParameterFloat* lowMidCrossover{ nullptr };
-    juce::AudioParameterFloat* midHighCrossover{ nullptr };
+    /** meters of whichever core is running */
+    float getRMSInputDb(size_t band) const;
+    float getRMSOutputDb(size_t band) const;
 
-    std::array <juce::AudioBuffer<float>, 3> filterBuffers;
+    /** the running core's gain reduction stream for a band, the editor is its only reader */
+    GainReductionStream& getGainReductionStream(size_t band);
 
-    juce::dsp::Gain<float> inputGain, outputGain;
+private:
+    std::array<juce::AudioParameterFloat*, Params::NumBands - 1> crossoverFrequencies{};
 
     juce::AudioParameterFloat* inputGainParam{ nullptr };
     juce::AudioParameterFloat* outputGainParam{ nullptr };
 
-    template<typename T, typename U>
-    void applyGain(T& buffer, U& gain)
+    juce::AudioParameterBool* linearPhaseParam{ nullptr };
+    juce::AudioParameterBool* sidechainParam{ nullptr };
+    juce::AudioParameterBool* parallelBandsParam{ nullptr };
+
+    //the audio thread only records the latency, the timer reports it to the host.
+    //The timer also starts and stops the band workers.
+    std::atomic<int> pendingLatencySamples{ 0 };
+    void timerCallback() override;
+
+    template <typename SampleType>
+    auto& getCore()
     {
-        auto block = juce::dsp::AudioBlock<float>(buffer);
-        auto ctx = juce::dsp::ProcessContextReplacing<float>(block);
-        gain.process(ctx);
+        if constexpr (std::is_same_v<SampleType, float>)
+            return floatCore;
+        else
+            return doubleCore;
     }
 
+    template <typename SampleType>
+    void prepareCore(const juce::dsp::ProcessSpec& spec);
+
+    template <typename SampleType>
     void updateState();
 
-    void splitBands(const juce::AudioBuffer<float>& inputBuffer);
+    template <typename SampleType>
+    void process(juce::AudioBuffer<SampleType>& buffer);
 
     juce::dsp::Oscillator<float> osc;
     juce::dsp::Gain<float> gain;
@@ -0,0 +1,270 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 17 Oct 2026 8:31:05pm
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <iostream>
+#include <mutex>
+#include "../PluginProcessor.h"
+
+/*
+ Offline batch render: runs audio files through SimpleMBCompAudioProcessor with the settings
+ from a saved plugin state, faster than real time and without a host.
+
+     SimpleMBCompRender --state <file> --out <folder> [--jobs N] [--block N] <input files...>
+
+ The state file is whatever getStateInformation wrote (e.g. a preset saved from a DAW session).
+ Each worker thread owns one processor and keeps taking the next file until none are left.
+ Outputs keep their input's name, format, sample rate and channel count, and are trimmed by the
+ plugin's latency so they line up sample for sample with the input.
+ */
+
+namespace
+{
+    struct RenderSettings
+    {
+        juce::MemoryBlock state;
+        juce::File outputFolder;
+        int blockSize{ 1024 };
+    };
+
+    juce::AudioFormatManager& getFormatManager()
+    {
+        //shared by every worker, it is only read once the formats are registered
+        static juce::AudioFormatManager manager;
+        static const bool registered = [] { manager.registerBasicFormats(); return true; }();
+        juce::ignoreUnused(registered);
+
+        return manager;
+    }
+
+    int pickBitDepth(juce::AudioFormat& format, int sourceBitDepth)
+    {
+        auto depths = format.getPossibleBitDepths();
+        if (depths.contains(sourceBitDepth) || depths.isEmpty())
+            return sourceBitDepth;
+
+        return depths[depths.size() - 1];
+    }
+
+    /** returns an empty string on success, otherwise what went wrong */
+    juce::String renderFile(SimpleMBCompAudioProcessor& processor, const juce::File& input, const RenderSettings& settings)
+    {
+        auto& formats = getFormatManager();
+
+        std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(input));
+        if (reader == nullptr)
+            return "unreadable or unsupported format";
+
+        const auto numChannels = static_cast<int>(reader->numChannels);
+        const auto channelSet = juce::AudioChannelSet::canonicalChannelSet(numChannels);
+
+        auto layout = processor.getBusesLayout();
+        layout.inputBuses.getReference(0) = channelSet;
+        layout.outputBuses.getReference(0) = channelSet;
+        for (int bus = 1; bus < layout.inputBuses.size(); ++bus)
+            layout.inputBuses.getReference(bus) = juce::AudioChannelSet::disabled();
+
+        if (! processor.setBusesLayout(layout))
+            return juce::String(numChannels) + " channels aren't supported";
+
+        auto output = settings.outputFolder.getChildFile(input.getFileName());
+        if (output == input)
+            return "would overwrite its own input";
+
+        auto* format = formats.findFormatForFileExtension(output.getFileExtension());
+        if (format == nullptr)
+            return "no writer for " + output.getFileExtension();
+
+        output.deleteFile();
+        auto stream = output.createOutputStream();
+        if (stream == nullptr)
+            return "can't write " + output.getFullPathName();
+
+        std::unique_ptr<juce::AudioFormatWriter> writer(format->createWriterFor(stream.get(),
+                                                                                 reader->sampleRate,
+                                                                                 reader->numChannels,
+                                                                                 pickBitDepth(*format, static_cast<int>(reader->bitsPerSample)),
+                                                                                 reader->metadataValues,
+                                                                                 0));
+        if (writer == nullptr)
+            return "can't create a " + format->getFormatName() + " writer";
+
+        stream.release(); //the writer owns it now
+
+        processor.setNonRealtime(true);
+        processor.prepareToPlay(reader->sampleRate, settings.blockSize);
+
+        juce::AudioBuffer<float> buffer(processor.getTotalNumInputChannels(), settings.blockSize);
+        juce::MidiBuffer midi;
+
+        const auto length = reader->lengthInSamples;
+        auto samplesToSkip = static_cast<juce::int64>(processor.getLatencySamples());
+        juce::int64 readPosition = 0, written = 0;
+
+        //keeps feeding silence past the end of the file until the delayed output has caught up
+        while (written < length)
+        {
+            buffer.clear();
+
+            const auto numToRead = static_cast<int>(juce::jlimit<juce::int64>(0, settings.blockSize, length - readPosition));
+            if (numToRead > 0)
+                reader->read(&buffer, 0, numToRead, readPosition, true, true);
+
+            readPosition += settings.blockSize;
+
+            processor.processBlock(buffer, midi);
+
+            const auto skipped = static_cast<int>(juce::jmin<juce::int64>(samplesToSkip, settings.blockSize));
+            samplesToSkip -= skipped;
+
+            const auto numToWrite = static_cast<int>(juce::jmin<juce::int64>(settings.blockSize - skipped, length - written));
+            if (numToWrite > 0 && ! writer->writeFromAudioSampleBuffer(buffer, skipped, numToWrite))
+                return "write failed";
+
+            written += numToWrite;
+        }
+
+        processor.releaseResources();
+        return {};
+    }
+
+    struct RenderWorker : juce::Thread
+    {
+        RenderWorker(int index, const juce::Array<juce::File>& filesToRender, std::atomic<int>& next, const RenderSettings& s)
+            : juce::Thread("Render worker " + juce::String(index + 1)), files(filesToRender), nextFile(next), settings(s)
+        {
+            //built up front, the message-thread parts of the processor don't like being created concurrently
+            processor = std::make_unique<SimpleMBCompAudioProcessor>();
+            processor->setStateInformation(settings.state.getData(), static_cast<int>(settings.state.getSize()));
+        }
+
+        void run() override
+        {
+            for (auto index = nextFile++; index < files.size() && ! threadShouldExit(); index = nextFile++)
+            {
+                auto& file = files.getReference(index);
+                auto start = juce::Time::getMillisecondCounterHiRes();
+                auto error = renderFile(*processor, file, settings);
+
+                auto message = file.getFileName() + ": ";
+                if (error.isEmpty())
+                    message << "done in " << juce::String((juce::Time::getMillisecondCounterHiRes() - start) / 1000.0, 2) << "s";
+                else
+                    message << error;
+
+                log(message);
+
+                if (error.isNotEmpty())
+                    ++failures;
+            }
+        }
+
+        static void log(const juce::String& message)
+        {
+            static std::mutex logLock;
+            std::lock_guard<std::mutex> lock(logLock);
+            std::cout << message << std::endl;
+        }
+
+        const juce::Array<juce::File>& files;
+        std::atomic<int>& nextFile;
+        const RenderSettings& settings;
+        std::unique_ptr<SimpleMBCompAudioProcessor> processor;
+        int failures{ 0 };
+    };
+
+    void printUsage()
+    {
+        std::cout << "usage: SimpleMBCompRender --state <file> --out <folder> [--jobs N] [--block N] <input files...>" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ArgumentList args(argc, argv);
+
+    //the option getters call ConsoleApplication::fail on bad input, which this turns into a message and exit code
+    return juce::ConsoleApplication::invokeCatchingFailures([&]
+    {
+        if (args.size() == 0 || args.containsOption("--help|-h"))
+        {
+            printUsage();
+            return 0;
+        }
+
+        RenderSettings settings;
+
+        auto stateFile = args.getExistingFileForOption("--state");
+        if (! stateFile.loadFileAsData(settings.state))
+            juce::ConsoleApplication::fail("couldn't read " + stateFile.getFullPathName());
+
+        settings.outputFolder = args.getFileForOption("--out");
+        if (! settings.outputFolder.createDirectory())
+            juce::ConsoleApplication::fail("couldn't create " + settings.outputFolder.getFullPathName());
+
+        if (args.containsOption("--block"))
+            settings.blockSize = juce::jlimit(32, 1 << 16, args.getValueForOption("--block").getIntValue());
+
+        auto numJobs = juce::SystemStats::getNumCpus();
+        if (args.containsOption("--jobs"))
+            numJobs = juce::jmax(1, args.getValueForOption("--jobs").getIntValue());
+
+        juce::Array<juce::File> files;
+        for (int i = 0; i < args.size(); ++i)
+        {
+            auto arg = args[i];
+
+            if (arg.isOption())
+            {
+                //"--jobs 4" takes the next argument along, "--jobs=4" doesn't
+                if (! arg.text.containsChar('='))
+                    ++i;
+
+                continue;
+            }
+
+            auto file = arg.resolveAsFile();
+            if (file.isDirectory())
+                file.findChildFiles(files, juce::File::findFiles, false, getFormatManager().getWildcardForAllFormats());
+            else
+                files.add(file);
+        }
+
+        if (files.isEmpty())
+            juce::ConsoleApplication::fail("no input files");
+
+        numJobs = juce::jmin(numJobs, files.size());
+
+        std::atomic<int> nextFile{ 0 };
+        std::vector<std::unique_ptr<RenderWorker>> workers;
+
+        for (int i = 0; i < numJobs; ++i)
+            workers.push_back(std::make_unique<RenderWorker>(i, files, nextFile, settings));
+
+        auto start = juce::Time::getMillisecondCounterHiRes();
+
+        for (auto& worker : workers)
+            worker->startThread();
+
+        auto failures = 0;
+        for (auto& worker : workers)
+        {
+            worker->waitForThreadToExit(-1);
+            failures += worker->failures;
+        }
+
+        std::cout << files.size() - failures << " of " << files.size() << " files rendered in "
+                  << juce::String((juce::Time::getMillisecondCounterHiRes() - start) / 1000.0, 2) << "s" << std::endl;
+
+        return failures == 0 ? 0 : 1;
+    });
+}